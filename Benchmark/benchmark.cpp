@@ -0,0 +1,113 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::benchmark::suite class implementation
+/// \ingroup benchmark
+
+#include "benchmark/benchmark.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/// \brief Writes a string as a JSON string literal
+/// \param os stream to write to
+/// \param str string to write
+void write_string(std::ostream& os, std::string const& str)
+{
+    os << '"';
+    for (auto c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\';
+        }
+        os << c;
+    }
+    os << '"';
+}
+
+}
+
+namespace blip {
+
+namespace benchmark {
+
+void const* volatile detail::sink = nullptr;
+
+void suite::add(std::string name, function_type function)
+{
+    auto pred = [&name](auto& e) { return e.name == name; };
+    if (std::any_of(std::begin(_entries), std::end(_entries), pred)) {
+        throw std::invalid_argument{"duplicate benchmark name"};
+    }
+    _entries.push_back({std::move(name), std::move(function)});
+}
+
+std::vector<result> suite::run(std::string const& filter) const
+{
+    std::vector<result> results;
+    for (auto&& e : _entries) {
+        if (filter.empty() || e.name.find(filter) != std::string::npos) {
+            results.emplace_back(run(e));
+        }
+    }
+    return results;
+}
+
+result suite::run(entry const& e) const
+{
+    auto time = [&e](std::size_t iterations)
+    {
+        auto start = clock_type::now();
+        e.function(iterations);
+        return clock_type::now() - start;
+    };
+
+    // Double the iterations until a sample is long enough to time reliably;
+    // the first run also warms caches and lazily initialized state
+    std::size_t iterations{1};
+    while (time(iterations) < _min_sample_time) {
+        iterations *= 2;
+    }
+
+    std::vector<double> times;
+    for (std::size_t n = 0; n < _samples; ++n) {
+        std::chrono::duration<double, std::nano> elapsed{time(iterations)};
+        times.emplace_back(elapsed.count() / iterations);
+    }
+    std::sort(std::begin(times), std::end(times));
+
+    result r;
+    r.name = e.name;
+    r.iterations = iterations;
+    r.samples = times.size();
+    r.median = times[times.size() / 2];
+    r.min = times.front();
+    r.max = times.back();
+    return r;
+}
+
+void write_json(std::ostream& os, std::vector<result> const& results)
+{
+    os << std::fixed << std::setprecision(3)
+        << "{\n  \"version\": 1,\n  \"unit\": \"ns\",\n  \"benchmarks\": [";
+    auto is_first = true;
+    for (auto&& r : results) {
+        os << (is_first ? "\n" : ",\n") << "    {\"name\": ";
+        write_string(os, r.name);
+        os << ", \"iterations\": " << r.iterations
+            << ", \"samples\": " << r.samples
+            << ", \"median\": " << r.median
+            << ", \"min\": " << r.min
+            << ", \"max\": " << r.max << '}';
+        is_first = false;
+    }
+    os << "\n  ]\n}\n";
+}
+
+}
+
+}
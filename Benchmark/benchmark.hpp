@@ -0,0 +1,134 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::benchmark::suite class interface
+/// \ingroup benchmark
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace blip {
+
+namespace benchmark {
+
+/// \addtogroup benchmark
+/// \{
+
+namespace detail {
+
+/// \brief Sink for values that must not be optimized away
+extern void const* volatile sink;
+
+}
+
+/// \brief Prevents the compiler from optimizing away a value
+/// \tparam T type of value
+/// \param value value to keep
+template <typename T>
+inline void keep(T const& value)
+{
+    detail::sink = &value;
+}
+
+/// \brief Timing of a single benchmark
+struct result
+{
+    std::string name; //!< Name of the benchmark
+    std::size_t iterations{0}; //!< Iterations timed per sample
+    std::size_t samples{0}; //!< Number of samples taken
+    double median{0.0}; //!< Median time per iteration in nanoseconds
+    double min{0.0}; //!< Shortest time per iteration in nanoseconds
+    double max{0.0}; //!< Longest time per iteration in nanoseconds
+};
+
+/// \brief Collection of named benchmarks
+///
+/// Each benchmark is a function that performs the measured operation a
+/// given number of times. The suite calibrates the number of iterations so
+/// that each sample takes at least \ref min_sample_time, then takes several
+/// samples and reports their median to damp scheduler noise.
+class suite
+{
+public:
+    /// \brief Type of benchmark function, given the number of iterations
+    using function_type = std::function<void(std::size_t)>;
+
+    /// \brief Type of clock used for timing
+    using clock_type = std::chrono::steady_clock;
+
+    /// \brief Gets the minimum time taken by a sample
+    /// \return minimum sample time
+    clock_type::duration min_sample_time() const noexcept
+    {
+        return _min_sample_time;
+    }
+
+    /// \brief Sets the minimum time taken by a sample
+    /// \param time minimum sample time
+    void min_sample_time(clock_type::duration time) noexcept
+    {
+        _min_sample_time = time;
+    }
+
+    /// \brief Gets the number of samples taken of each benchmark
+    /// \return number of samples
+    std::size_t samples() const noexcept { return _samples; }
+
+    /// \brief Sets the number of samples taken of each benchmark
+    /// \param count number of samples, at least 1
+    void samples(std::size_t count) noexcept
+    {
+        _samples = count > 0 ? count : 1;
+    }
+
+    /// \brief Adds a benchmark to the suite
+    /// \param name unique name of the benchmark
+    /// \param function benchmark function
+    void add(std::string name, function_type function);
+
+    /// \brief Runs the benchmarks whose names contain a filter
+    /// \param filter substring of the names to run, or empty to run all
+    /// \return results of the benchmarks in the order they were added
+    std::vector<result> run(std::string const& filter = {}) const;
+
+private:
+    /// \brief Named benchmark function
+    struct entry
+    {
+        std::string name; //!< Name of the benchmark
+        function_type function; //!< Benchmark function
+    };
+
+    std::vector<entry> _entries; //!< Benchmarks in the suite
+
+    /// \brief Minimum time taken by a sample
+    clock_type::duration _min_sample_time{std::chrono::milliseconds{20}};
+
+    std::size_t _samples{7}; //!< Number of samples taken of each benchmark
+
+    /// \brief Runs a single benchmark
+    /// \param e benchmark to run
+    /// \return result of the benchmark
+    result run(entry const& e) const;
+};
+
+/// \brief Writes benchmark results as JSON
+/// \param os stream to write to
+/// \param results results to write
+///
+/// The output has a fixed layout, with one benchmark per line in the order
+/// given, so that results from different builds can be compared textually.
+void write_json(std::ostream& os, std::vector<result> const& results);
+
+/// \}
+
+}
+
+}
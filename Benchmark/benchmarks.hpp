@@ -0,0 +1,44 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the benchmark registration function interfaces
+/// \ingroup benchmark
+
+#pragma once
+
+#include <string>
+
+namespace blip {
+
+namespace benchmark {
+
+// Forward declarations
+class suite;
+
+/// \addtogroup benchmark
+/// \{
+
+/// \brief Adds benchmarks of input mapping and input XML loading
+/// \param s suite to add to
+/// \param resources_path path to the application resources
+void add_input_benchmarks(suite& s, std::string const& resources_path);
+
+/// \brief Adds benchmarks of resource caching and archive loading
+/// \param s suite to add to
+/// \param resources_path path to the application resources
+void add_resource_benchmarks(suite& s, std::string const& resources_path);
+
+/// \brief Adds benchmarks of state management
+/// \param s suite to add to
+void add_state_benchmarks(suite& s);
+
+/// \brief Adds benchmarks of lexical casting and path manipulation
+/// \param s suite to add to
+void add_utility_benchmarks(suite& s);
+
+/// \}
+
+}
+
+}
@@ -0,0 +1,401 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the input benchmarks
+/// \ingroup benchmark
+
+#include "benchmark/benchmarks.hpp"
+#include "benchmark/benchmark.hpp"
+#include "blip/coalesce.hpp"
+#include "blip/fixed_vector.hpp"
+#include "blip/input_map.hpp"
+#include "blip/input_specification.hpp"
+#include "blip/path.hpp"
+#include "blip/xml_deserializer.hpp"
+#include <SFML/Window/Event.hpp>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+using namespace blip;
+
+/// \brief Input configuration shared by the input benchmarks
+struct input_fixture
+{
+    std::string spec_path; //!< Path to the input specification
+    std::string map_path; //!< Path to the default input map
+    input_specification spec; //!< Input specification
+    input_map map; //!< Default input map
+};
+
+/// \brief Loads an input specification
+/// \param path path to the specification file
+/// \param spec specification to load into
+void load(std::string const& path, input_specification& spec)
+{
+    pugi::xml_document doc;
+    if (!doc.load_file(path.c_str())) {
+        throw std::runtime_error{"unable to load input specification"};
+    }
+    xml_deserializer dx{doc};
+    if (!dx.child("InputSpecification", spec)) {
+        throw std::runtime_error{"unable to load input specification"};
+    }
+}
+
+/// \brief Loads an input map
+/// \param path path to the map file
+/// \param spec specification the map refers to
+/// \param map map to load into
+void load(
+    std::string const& path,
+    input_specification const& spec,
+    input_map& map)
+{
+    pugi::xml_document doc;
+    if (!doc.load_file(path.c_str())) {
+        throw std::runtime_error{"unable to load input map"};
+    }
+    xml_deserializer dx{doc};
+    if (!dx.child("InputMap", map, spec)) {
+        throw std::runtime_error{"unable to load input map"};
+    }
+}
+
+/// \brief Makes a key press event
+/// \param code key pressed
+/// \return key press event
+sf::Event key_pressed(sf::Keyboard::Key code)
+{
+    sf::Event event;
+    event.type = sf::Event::KeyPressed;
+    event.key.code = code;
+    event.key.alt = false;
+    event.key.control = false;
+    event.key.shift = false;
+    event.key.system = false;
+    return event;
+}
+
+/// \brief Adds a benchmark of mapping an event through the whole map
+/// \param s suite to add to
+/// \param name name of the benchmark
+/// \param fixture input configuration
+/// \param event event to map
+void add_map(
+    benchmark::suite& s,
+    std::string name,
+    std::shared_ptr<input_fixture> fixture,
+    sf::Event event)
+{
+    s.add(std::move(name), [fixture, event](std::size_t iterations)
+    {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto events = fixture->map.map(event);
+            benchmark::keep(events);
+        }
+    });
+}
+
+/// \brief Adds a benchmark of mapping a noisy stick at rest
+/// \param s suite to add to
+/// \param name name of the benchmark
+/// \param fixture input configuration
+/// \param activation activation of the stick axis
+void add_stick_noise(
+    benchmark::suite& s,
+    std::string name,
+    std::shared_ptr<input_fixture> fixture,
+    input_analog_activation activation)
+{
+    s.add(std::move(name), [fixture, activation](std::size_t iterations)
+    {
+        auto& action_context = fixture->spec.at("Game");
+        input_binding_context context;
+        context.action_context = &action_context;
+        context.action = &action_context.at("MoveHorizontal");
+        input_binding binding;
+        binding.device = input_device::controller;
+        binding.controller.control = input_controller_control::axis;
+        binding.controller.axis.code = sf::Joystick::X;
+        binding.controller.axis.activation = activation;
+        binding.controller.axis.is_paired = true;
+        binding.controller.axis.paired_code = sf::Joystick::Y;
+        context.bindings.emplace_back(binding);
+        input_map map;
+        map.contexts.emplace_back(std::move(context));
+        map.rebuild();
+
+        // Alternate both axes through small offsets, as a worn stick does
+        sf::Event move;
+        move.type = sf::Event::JoystickMoved;
+        move.joystickMove.joystickId = 0;
+        std::vector<input_event> events;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            move.joystickMove.axis = i % 2 == 0
+                ? sf::Joystick::X
+                : sf::Joystick::Y;
+            move.joystickMove.position = static_cast<float>(i % 7) - 3.0f;
+            events.clear();
+            map.map(move, events);
+            benchmark::keep(events);
+        }
+    });
+}
+
+/// \brief Makes the events of a frame in which several controllers report
+/// many small stick moves
+/// \return events of the frame
+std::vector<sf::Event> joystick_flood()
+{
+    std::vector<sf::Event> events;
+    for (unsigned sample = 0; sample < 8; ++sample) {
+        for (unsigned joystick = 0; joystick < 4; ++joystick) {
+            for (auto axis : {sf::Joystick::X, sf::Joystick::Y,
+                sf::Joystick::U, sf::Joystick::V})
+            {
+                sf::Event move;
+                move.type = sf::Event::JoystickMoved;
+                move.joystickMove.joystickId = joystick;
+                move.joystickMove.axis = axis;
+                move.joystickMove.position = 50.0f + sample;
+                events.emplace_back(move);
+            }
+        }
+        events.emplace_back(key_pressed(sf::Keyboard::A));
+    }
+    return events;
+}
+
+/// \brief Adds a benchmark of mapping every event of a frame
+/// \param s suite to add to
+/// \param name name of the benchmark
+/// \param fixture input configuration
+/// \param should_coalesce whether joystick moves are coalesced first
+void add_map_frame(
+    benchmark::suite& s,
+    std::string name,
+    std::shared_ptr<input_fixture> fixture,
+    bool should_coalesce)
+{
+    s.add(std::move(name), [fixture, should_coalesce](
+        std::size_t iterations)
+    {
+        auto flood = joystick_flood();
+        std::vector<sf::Event> frame;
+        std::vector<input_event> events;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            frame = flood;
+            if (should_coalesce) {
+                coalesce_joystick_moves(frame);
+            }
+            events.clear();
+            for (auto&& e : frame) {
+                fixture->map.map(e, events);
+            }
+            benchmark::keep(events);
+        }
+    });
+}
+
+}
+
+namespace blip {
+
+namespace benchmark {
+
+void add_input_benchmarks(suite& s, std::string const& resources_path)
+{
+    auto fixture = std::make_shared<input_fixture>();
+    auto configs_path = join_path({resources_path, "Configurations"});
+    fixture->spec_path = join_path({configs_path, "InputSpecification.xml"});
+    fixture->map_path = join_path({configs_path, "InputMap.xml"});
+    load(fixture->spec_path, fixture->spec);
+    load(fixture->map_path, fixture->spec, fixture->map);
+
+    add_map(s, "input_map/map/bound_key", fixture,
+        key_pressed(sf::Keyboard::A));
+    add_map(s, "input_map/map/unbound_key", fixture,
+        key_pressed(sf::Keyboard::F12));
+
+    sf::Event move;
+    move.type = sf::Event::JoystickMoved;
+    move.joystickMove.joystickId = 0;
+    move.joystickMove.axis = sf::Joystick::X;
+    move.joystickMove.position = 50.0f;
+    add_map(s, "input_map/map/joystick_move", fixture, move);
+
+    sf::Event mouse;
+    mouse.type = sf::Event::MouseMoved;
+    mouse.mouseMove.x = 320;
+    mouse.mouseMove.y = 240;
+    add_map(s, "input_map/map/unmapped_event", fixture, mouse);
+
+    s.add("input_map/map_reused/bound_key", [fixture](std::size_t iterations)
+    {
+        auto event = key_pressed(sf::Keyboard::A);
+        std::vector<input_event> events;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            events.clear();
+            fixture->map.map(event, events);
+            keep(events);
+        }
+    });
+
+    s.add("input_map/map_fixed/bound_key", [fixture](std::size_t iterations)
+    {
+        auto event = key_pressed(sf::Keyboard::A);
+        fixed_vector<input_event, 16> events;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            events.clear();
+            fixture->map.map(event, events);
+            keep(events);
+        }
+    });
+
+    s.add("input_map/map_reused/large_map", [fixture](std::size_t iterations)
+    {
+        // Bind every key and controller control to every action so that the
+        // map holds hundreds of bindings
+        input_map map;
+        for (auto&& action_context : fixture->spec.contexts) {
+            for (auto&& action : action_context.actions) {
+                input_binding_context context;
+                context.action_context = &action_context;
+                context.action = &action;
+                for (unsigned code = 0; code < 16; ++code) {
+                    input_binding binding;
+                    binding.device = input_device::keyboard;
+                    binding.keyboard.control = input_keyboard_control::key;
+                    binding.keyboard.key.code =
+                        code + context.bindings.size();
+                    context.bindings.emplace_back(binding);
+                }
+                map.contexts.emplace_back(std::move(context));
+            }
+        }
+        map.rebuild();
+
+        auto event = key_pressed(sf::Keyboard::A);
+        std::vector<input_event> events;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            events.clear();
+            map.map(event, events);
+            keep(events);
+        }
+    });
+
+    input_analog_activation raw;
+    raw.clear();
+    add_stick_noise(s, "input_map/map_reused/stick_noise_raw", fixture,
+        raw);
+
+    auto filtered = raw;
+    filtered.dead_zone = 0.15f;
+    filtered.dead_zone_shape = input_dead_zone_shape::radial;
+    filtered.epsilon = 0.01f;
+    add_stick_noise(s, "input_map/map_reused/stick_noise_filtered", fixture,
+        filtered);
+
+    add_map_frame(s, "input_map/map_frame/joystick_flood", fixture, false);
+    add_map_frame(s, "input_map/map_frame/joystick_flood_coalesced", fixture,
+        true);
+
+    // Rebinding a single action updates the dispatch table for its context
+    // only, where loading the map again rebuilds it for every context
+    auto make_large_map = [fixture]
+    {
+        input_map map;
+        for (auto&& action_context : fixture->spec.contexts) {
+            for (auto&& action : action_context.actions) {
+                for (unsigned code = 0; code < 16; ++code) {
+                    input_binding binding;
+                    binding.device = input_device::keyboard;
+                    binding.keyboard.control = input_keyboard_control::key;
+                    binding.keyboard.key.code = code;
+                    map.bind(&action_context, &action, binding);
+                }
+            }
+        }
+        return map;
+    };
+
+    s.add("input_map/rebind/large_map", [make_large_map](
+        std::size_t iterations)
+    {
+        auto map = make_large_map();
+        auto& context = map.contexts.front();
+        auto binding = context.bindings.front();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            binding.keyboard.key.code = i % 16;
+            map.rebind(context.action_context, context.action, 0, binding);
+            keep(map);
+        }
+    });
+
+    s.add("input_map/rebuild/large_map", [make_large_map](
+        std::size_t iterations)
+    {
+        auto map = make_large_map();
+        auto& binding = map.contexts.front().bindings.front();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            binding.keyboard.key.code = i % 16;
+            map.rebuild();
+            keep(map);
+        }
+    });
+
+    s.add("input_map/map_context/bound_key", [fixture](std::size_t iterations)
+    {
+        auto context = &fixture->spec.at("Game");
+        auto event = key_pressed(sf::Keyboard::A);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto events = fixture->map.map(event, context);
+            keep(events);
+        }
+    });
+
+    s.add("input_specification/find", [fixture](std::size_t iterations)
+    {
+        // Resolve the last action of the last context, the worst case for a
+        // linear search
+        auto& action_context = fixture->spec.contexts.back();
+        auto& action = action_context.actions.back();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto& c = fixture->spec.at(action_context.name);
+            keep(c.at(action.name));
+        }
+    });
+
+    s.add("input_map/find", [fixture](std::size_t iterations)
+    {
+        auto& context = fixture->map.contexts.back();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            keep(fixture->map.find(context.action_context, context.action));
+        }
+    });
+
+    s.add("xml/load_input_specification", [fixture](std::size_t iterations)
+    {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            input_specification spec;
+            load(fixture->spec_path, spec);
+            keep(spec);
+        }
+    });
+
+    s.add("xml/load_input_map", [fixture](std::size_t iterations)
+    {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            input_map map;
+            load(fixture->map_path, fixture->spec, map);
+            keep(map);
+        }
+    });
+}
+
+}
+
+}
@@ -0,0 +1,95 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref main function of the benchmark suite
+/// \ingroup benchmark
+
+#include "benchmark/benchmark.hpp"
+#include "benchmark/benchmarks.hpp"
+#include "blip/lexical_cast.hpp"
+#include "blip/path.hpp"
+#include "blip/string.hpp"
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+/// \addtogroup benchmark
+/// \{
+
+/// \brief The entry point of the benchmark suite
+/// \param argc number of command line arguments
+/// \param argv command line arguments
+/// \return exit status of the program
+///
+/// Results are written as JSON to standard output, or to the file given by
+/// \c --output=PATH. The following options are also accepted:
+/// - \c --filter=TEXT runs only the benchmarks whose names contain \c TEXT
+/// - \c --samples=N takes \c N samples of each benchmark
+/// - \c --resources=PATH loads resources from \c PATH instead of the
+///   application resources path
+int main(int argc, char* argv[])
+{
+    using namespace blip;
+
+    benchmark::suite suite;
+    std::string filter;
+    std::string output;
+    std::string resources_path;
+    for (auto i = 1; i < argc; ++i) {
+        std::string arg{argv[i]};
+        std::string value;
+        std::size_t samples;
+        if (parse_option(arg, "--filter", value)) {
+            filter = value;
+        }
+        else if (parse_option(arg, "--output", value)) {
+            output = value;
+        }
+        else if (parse_option(arg, "--resources", value)) {
+            resources_path = value;
+        }
+        else if (parse_option(arg, "--samples", value)
+            && try_lexical_cast(value, samples)) {
+            suite.samples(samples);
+        }
+        else {
+            std::cerr << "invalid option: " << arg << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        if (resources_path.empty()) {
+            resources_path = join_path({
+                find_system_path(system_path::resources_path), "Resources"});
+        }
+
+        benchmark::add_input_benchmarks(suite, resources_path);
+        benchmark::add_resource_benchmarks(suite, resources_path);
+        benchmark::add_state_benchmarks(suite);
+        benchmark::add_utility_benchmarks(suite);
+
+        auto results = suite.run(filter);
+        if (output.empty()) {
+            benchmark::write_json(std::cout, results);
+        }
+        else {
+            std::ofstream os{output};
+            benchmark::write_json(os, results);
+            if (!os) {
+                std::cerr << "unable to write " << output << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    catch (std::exception const& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/// \}
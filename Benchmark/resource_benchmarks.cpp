@@ -0,0 +1,512 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the resource benchmarks
+/// \ingroup benchmark
+
+#include "benchmark/benchmarks.hpp"
+#include "benchmark/benchmark.hpp"
+#include "blip/lexical_cast.hpp"
+#include "blip/path.hpp"
+#include "blip/resource_archive.hpp"
+#include "blip/resource_handle.hpp"
+#include "blip/resource_manager.hpp"
+#include "blip/worker_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace blip;
+
+/// \brief Number of distinct resources used by the benchmarks
+constexpr std::size_t resource_count = 1000;
+
+/// \brief Resource type with a nontrivial payload
+struct dummy_resource
+{
+    std::vector<char> data; //!< Resource contents
+};
+
+/// \brief Type of cache used by the benchmarks
+using dummy_cache = typed_resource_cache<dummy_resource>;
+
+/// \brief Creates a cache of dummy resources
+/// \return resource cache
+std::unique_ptr<dummy_cache> make_cache()
+{
+    return std::make_unique<dummy_cache>([](dummy_cache::name_type const&)
+    {
+        auto ptr = std::make_shared<dummy_resource>();
+        ptr->data.resize(64);
+        return ptr;
+    });
+}
+
+/// \brief Number of resources loaded by the slow creator benchmarks
+constexpr std::size_t slow_batch_size = 16;
+
+/// \brief Time taken by the slow creator to create each resource
+constexpr std::chrono::microseconds slow_create_time{200};
+
+/// \brief Creates a cache of dummy resources that are slow to create, as
+/// resources decoded from disk are
+/// \return resource cache
+std::unique_ptr<dummy_cache> make_slow_cache()
+{
+    return std::make_unique<dummy_cache>([](dummy_cache::name_type const&)
+    {
+        auto until = std::chrono::steady_clock::now() + slow_create_time;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        auto ptr = std::make_shared<dummy_resource>();
+        ptr->data.resize(64);
+        return ptr;
+    });
+}
+
+/// \brief Number of resources used by each state in the transition
+/// benchmarks
+constexpr std::size_t state_resource_count = 16;
+
+/// \brief Number of threads used by the contended benchmarks
+constexpr std::size_t contended_thread_count = 8;
+
+/// \brief Number of gets made by each thread of the contended stress test
+constexpr std::size_t contended_get_count = 100000;
+
+/// \brief Path of the archive packed for the archive benchmarks
+char const* const archive_path = "Benchmark.pack";
+
+/// \brief Archive of the resources, packed once when the benchmarks are
+/// added and removed when they are destroyed
+struct packed_resources
+{
+    resource_archive archive; //!< Archive, which is closed if not packed
+
+    /// \brief Initializes a new instance of the \ref packed_resources
+    /// structure, packing the files into \ref archive_path
+    /// \param root path to the resources directory
+    /// \param files paths of the files to pack, relative to \p root
+    packed_resources(
+        std::string const& root,
+        std::vector<std::string> const& files)
+    {
+        if (!files.empty()) {
+            resource_archive::pack(archive_path, root, files);
+            archive = resource_archive{archive_path};
+        }
+    }
+
+    /// \brief Deleted copy constructor
+    packed_resources(packed_resources const&) = delete;
+
+    /// \brief Destructs the \ref packed_resources instance, closing and
+    /// removing the archive
+    ~packed_resources()
+    {
+        if (archive.is_open()) {
+            archive = resource_archive{};
+            std::remove(archive_path);
+        }
+    }
+
+    /// \brief Deleted copy assignment operator
+    packed_resources& operator=(packed_resources const&) = delete;
+};
+
+/// \brief Creates resource names of the form used by the application
+/// \return resource names
+std::vector<std::string> make_names()
+{
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < resource_count; ++i) {
+        names.emplace_back("Images/Sprites/sprite_"
+            + lexical_cast<std::string>(i) + ".png");
+    }
+    return names;
+}
+
+}
+
+namespace blip {
+
+namespace benchmark {
+
+void add_resource_benchmarks(suite& s, std::string const& resources_path)
+{
+    auto names = std::make_shared<std::vector<std::string>>(make_names());
+    auto files = std::make_shared<std::vector<std::string>>(
+        list_files(resources_path));
+    auto packed = std::make_shared<packed_resources>(resources_path, *files);
+
+    s.add("resource_cache/get/hit", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        std::vector<dummy_cache::ptr_type> held;
+        for (auto&& name : *names) {
+            held.emplace_back(cache->get(name));
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto ptr = cache->get((*names)[i % names->size()]);
+            keep(ptr);
+        }
+    });
+
+    // Names given as literals are looked up without being copied
+    s.add("resource_cache/get/hit_literal", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        std::vector<dummy_cache::ptr_type> held;
+        for (auto&& name : *names) {
+            held.emplace_back(cache->get(name));
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto ptr = cache->get((*names)[i % names->size()].c_str());
+            keep(ptr);
+        }
+    });
+
+    // Names given as handles are looked up without being hashed
+    s.add("resource_cache/get/hit_handle", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        std::vector<dummy_cache::ptr_type> held;
+        std::vector<resource_handle> handles;
+        for (auto&& name : *names) {
+            held.emplace_back(cache->get(name));
+            handles.emplace_back(name);
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto ptr = cache->get(handles[i % handles.size()]);
+            keep(ptr);
+        }
+    });
+
+    s.add("resource_cache/get/create", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            // The resource expires immediately, so every get creates it
+            auto ptr = cache->get((*names)[i % names->size()]);
+            keep(ptr);
+        }
+    });
+
+    // Stress test: threads hammer the cache with the same names at once,
+    // holding every resource so that each must be created exactly once. Each
+    // iteration is a whole run of a fixed number of gets, so that the test
+    // is as thorough however few iterations calibration settles on.
+    s.add("resource_cache/get/contended", [names](std::size_t iterations)
+    {
+        for (std::size_t run = 0; run < iterations; ++run) {
+            std::atomic<std::size_t> created{0};
+            dummy_cache cache{[&created](dummy_cache::name_type const&)
+            {
+                ++created;
+                auto ptr = std::make_shared<dummy_resource>();
+                ptr->data.resize(64);
+                return ptr;
+            }};
+
+            // Resources are held until every thread has finished, so that
+            // none expires and is legitimately created again. Failures are
+            // counted rather than thrown, as an exception escaping a thread
+            // would terminate the program.
+            std::atomic<std::size_t> changed{0};
+            std::vector<std::vector<dummy_cache::ptr_type>> helds(
+                contended_thread_count,
+                std::vector<dummy_cache::ptr_type>(names->size()));
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < contended_thread_count; ++t) {
+                threads.emplace_back([&cache, &names, &helds, &changed, t]
+                {
+                    auto& held = helds[t];
+                    for (std::size_t i = 0; i < contended_get_count; ++i) {
+                        auto index = (i * 7 + t) % names->size();
+                        auto ptr = cache.get((*names)[index]);
+                        if (held[index] != nullptr && held[index] != ptr) {
+                            ++changed;
+                        }
+                        held[index] = std::move(ptr);
+                    }
+                });
+            }
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+
+            if (changed > 0) {
+                throw std::runtime_error{"resource changed"};
+            }
+            if (created != names->size()) {
+                throw std::runtime_error{"resource not created exactly once"};
+            }
+        }
+    });
+
+    s.add("resource_cache/get/hit_retained", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        cache->retention_budget(names->size() * sizeof(dummy_resource));
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto ptr = cache->get((*names)[i % names->size()]);
+            keep(ptr);
+        }
+    });
+
+    // States alternate, each releasing its resources before the next loads
+    // its own, so resources shared by both are reloaded unless retained
+    auto add_transition = [&s, names](char const* name, bool is_retained)
+    {
+        s.add(name, [names, is_retained](std::size_t iterations)
+        {
+            auto cache = make_slow_cache();
+            if (is_retained) {
+                cache->retention_budget(
+                    2 * state_resource_count * sizeof(dummy_resource));
+            }
+            std::vector<dummy_cache::ptr_type> held;
+            for (std::size_t i = 0; i < iterations; ++i) {
+                held.clear();
+                auto first = (i % 2) * state_resource_count / 2;
+                for (std::size_t j = 0; j < state_resource_count; ++j) {
+                    held.emplace_back(cache->get((*names)[first + j]));
+                }
+                cache->sweep();
+            }
+        });
+    };
+    add_transition("resource_cache/transition/weak", false);
+    add_transition("resource_cache/transition/retained", true);
+
+    s.add("resource_cache/sweep/live", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        std::vector<dummy_cache::ptr_type> held;
+        for (auto&& name : *names) {
+            held.emplace_back(cache->get(name));
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            cache->sweep();
+        }
+    });
+
+    s.add("resource_cache/sweep/expired", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            for (auto&& name : *names) {
+                cache->get(name);
+            }
+            cache->sweep();
+        }
+    });
+
+    s.add("resource_cache/get/slow_batch", [names](std::size_t iterations)
+    {
+        auto cache = make_slow_cache();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < slow_batch_size; ++j) {
+                auto ptr = cache->get((*names)[j]);
+                keep(ptr);
+            }
+        }
+    });
+
+    s.add("resource_cache/get_async/hit", [names](std::size_t iterations)
+    {
+        auto cache = make_cache();
+        worker_pool workers{1};
+        std::vector<dummy_cache::ptr_type> held;
+        for (auto&& name : *names) {
+            held.emplace_back(cache->get(name));
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto future = cache->get_async(
+                (*names)[i % names->size()], workers);
+            keep(future);
+        }
+    });
+
+    // Each iteration starts loading a batch through an asynchronous creator
+    // and gets it synchronously at once, which must wait for the loads
+    // rather than creating the resources a second time
+    s.add("resource_cache/get_mixed/slow_batch", [names](
+        std::size_t iterations)
+    {
+        worker_pool workers;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            std::atomic<std::size_t> created{0};
+            auto slow_cache = make_slow_cache();
+            dummy_cache cache{
+                [&created](dummy_cache::name_type const&)
+                    -> dummy_cache::ptr_type
+                {
+                    ++created;
+                    return std::make_shared<dummy_resource>();
+                },
+                [&created, &slow_cache](
+                    dummy_cache::name_type const& name,
+                    worker_pool& pool)
+                    -> dummy_cache::future_type
+                {
+                    ++created;
+                    return slow_cache->get_async(name, pool);
+                }};
+
+            std::vector<dummy_cache::future_type> futures;
+            for (std::size_t j = 0; j < slow_batch_size; ++j) {
+                futures.emplace_back(cache.get_async((*names)[j], workers));
+            }
+            for (std::size_t j = 0; j < slow_batch_size; ++j) {
+                auto ptr = cache.get((*names)[j]);
+                if (ptr == nullptr || ptr != futures[j].get()) {
+                    throw std::runtime_error{"resource created twice"};
+                }
+                keep(ptr);
+            }
+            if (created != slow_batch_size) {
+                throw std::runtime_error{"resource created twice"};
+            }
+        }
+    });
+
+    s.add("resource_cache/get_async/slow_batch", [names](
+        std::size_t iterations)
+    {
+        auto cache = make_slow_cache();
+        worker_pool workers;
+        std::vector<dummy_cache::future_type> futures;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            futures.clear();
+            for (std::size_t j = 0; j < slow_batch_size; ++j) {
+                futures.emplace_back(cache->get_async((*names)[j], workers));
+            }
+            for (auto&& future : futures) {
+                auto ptr = future.get();
+                keep(ptr);
+            }
+            cache->sweep();
+        }
+    });
+
+    // Each iteration reads the contents of one resource file, either from
+    // its loose file or from the archive
+    s.add("resource_archive/read/loose", [files, resources_path](
+        std::size_t iterations)
+    {
+        if (files->empty()) {
+            throw std::runtime_error{"no resources found"};
+        }
+        std::vector<char> contents;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto path = join_path({resources_path,
+                (*files)[i % files->size()]});
+            std::ifstream is{path, std::ios::binary};
+            contents.assign(std::istreambuf_iterator<char>{is},
+                std::istreambuf_iterator<char>{});
+            keep(contents);
+        }
+    });
+
+    s.add("resource_archive/read/packed", [files, packed](
+        std::size_t iterations)
+    {
+        if (files->empty()) {
+            throw std::runtime_error{"no resources found"};
+        }
+        std::vector<char> contents;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto blob = packed->archive.find((*files)[i % files->size()]);
+            if (blob.data == nullptr) {
+                throw std::runtime_error{"resource not packed"};
+            }
+            contents.assign(blob.data, blob.data + blob.size);
+            keep(contents);
+        }
+    });
+
+    // Each iteration prefetches a state's worth of slow resources and waits
+    // for them, as a pushed state does
+    s.add("resource_manager/prefetch/slow_batch", [names](
+        std::size_t iterations)
+    {
+        resource_manager mgr{"Resources"};
+        mgr.add_cache<dummy_resource>(make_slow_cache());
+        resource_manifest manifest;
+        for (std::size_t j = 0; j < state_resource_count; ++j) {
+            manifest.add<dummy_resource>((*names)[j]);
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto prefetch = mgr.prefetch(manifest);
+            while (!prefetch.is_ready()) {
+                std::this_thread::yield();
+            }
+            keep(prefetch);
+            mgr.sweep();
+        }
+    });
+
+    // Each iteration reloads a state's worth of slow resources in use and
+    // replaces them as the main thread does between frames
+    s.add("resource_manager/reload/slow_batch", [names](
+        std::size_t iterations)
+    {
+        resource_manager mgr{"Resources"};
+        mgr.add_cache<dummy_resource>(make_slow_cache());
+        std::vector<dummy_cache::ptr_type> held;
+        for (std::size_t j = 0; j < state_resource_count; ++j) {
+            held.emplace_back(mgr.get<dummy_resource>((*names)[j]));
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            for (std::size_t j = 0; j < state_resource_count; ++j) {
+                mgr.reload<dummy_resource>((*names)[j]);
+            }
+            for (std::size_t replaced = 0;
+                replaced < state_resource_count;)
+            {
+                replaced += mgr.apply_reloads();
+                std::this_thread::yield();
+            }
+        }
+        keep(held);
+    });
+
+    s.add("resource_manager/cache_for", [](std::size_t iterations)
+    {
+        resource_manager mgr{"Resources"};
+        mgr.add_cache<dummy_resource>(make_cache());
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto cache = mgr.cache_for<dummy_resource>();
+            keep(cache);
+        }
+    });
+
+    s.add("resource_manager/get/hit", [names](std::size_t iterations)
+    {
+        resource_manager mgr{"Resources"};
+        mgr.add_cache<dummy_resource>(make_cache());
+        std::vector<dummy_cache::ptr_type> held;
+        for (auto&& name : *names) {
+            held.emplace_back(mgr.get<dummy_resource>(name));
+        }
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto ptr = mgr.get<dummy_resource>((*names)[i % names->size()]);
+            keep(ptr);
+        }
+    });
+}
+
+}
+
+}
@@ -0,0 +1,135 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the state benchmarks
+/// \ingroup benchmark
+
+#include "benchmark/benchmarks.hpp"
+#include "benchmark/benchmark.hpp"
+#include "blip/state_manager.hpp"
+#include <SFML/Window/Event.hpp>
+#include <memory>
+
+namespace {
+
+using namespace blip;
+
+/// \brief Depth of the state stacks used by the benchmarks
+constexpr std::size_t stack_depth = 64;
+
+/// \brief State that does a trivial amount of work
+class dummy_state final : public state
+{
+public:
+    /// \brief Initializes a new instance of the \ref dummy_state class with
+    /// the given type
+    /// \param t type of state
+    explicit dummy_state(state_type t) : state{t} {}
+
+    /// \brief Counts the event without intercepting it
+    /// \return false
+    bool notify(sf::Event const&) override
+    {
+        ++_count;
+        return false;
+    }
+
+    /// \brief Accumulates the time step
+    /// \param time_step time step to update by
+    void update(float time_step) override
+    {
+        _time += time_step;
+    }
+
+protected:
+    /// \brief Draws nothing
+    void draw(sf::RenderTarget&, sf::RenderStates) const override
+    {
+    }
+
+private:
+    std::size_t _count{0}; //!< Number of events received
+    float _time{0.0f}; //!< Time accumulated by updates
+};
+
+/// \brief Fills a state manager with overlays on top of a primary state
+/// \param mgr manager to fill
+void fill(state_manager& mgr)
+{
+    mgr.push_back(std::make_unique<dummy_state>(state_type::primary));
+    for (std::size_t i = 1; i < stack_depth; ++i) {
+        mgr.push_back(std::make_unique<dummy_state>(state_type::overlay));
+    }
+}
+
+}
+
+namespace blip {
+
+namespace benchmark {
+
+void add_state_benchmarks(suite& s)
+{
+    s.add("state_manager/push_pop/deep", [](std::size_t iterations)
+    {
+        state_manager mgr;
+        fill(mgr);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            mgr.push_back(std::make_unique<dummy_state>(state_type::overlay));
+            mgr.pop_back();
+        }
+    });
+
+    s.add("state_manager/push_pop/primary", [](std::size_t iterations)
+    {
+        state_manager mgr;
+        fill(mgr);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            mgr.push_back(std::make_unique<dummy_state>(state_type::primary));
+            mgr.pop_back();
+        }
+    });
+
+    s.add("state_manager/notify/deep", [](std::size_t iterations)
+    {
+        state_manager mgr;
+        fill(mgr);
+        sf::Event event;
+        event.type = sf::Event::MouseMoved;
+        event.mouseMove.x = 0;
+        event.mouseMove.y = 0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            keep(mgr.notify(event));
+        }
+    });
+
+    s.add("state_manager/update/deep", [](std::size_t iterations)
+    {
+        state_manager mgr;
+        fill(mgr);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            mgr.update(1.0f / 60.0f);
+        }
+    });
+
+    s.add("state_manager/work/queued", [](std::size_t iterations)
+    {
+        state_manager mgr;
+        fill(mgr);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            // Holding the lock forces the changes onto the job queue
+            {
+                std::lock_guard<state_manager::mutex_type> lock{mgr.mutex};
+                mgr.push_back(
+                    std::make_unique<dummy_state>(state_type::overlay));
+                mgr.pop_back();
+            }
+            mgr.work();
+        }
+    });
+}
+
+}
+
+}
@@ -0,0 +1,66 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the utility benchmarks
+/// \ingroup benchmark
+
+#include "benchmark/benchmarks.hpp"
+#include "benchmark/benchmark.hpp"
+#include "blip/lexical_cast.hpp"
+#include "blip/path.hpp"
+#include <string>
+#include <vector>
+
+namespace blip {
+
+namespace benchmark {
+
+void add_utility_benchmarks(suite& s)
+{
+    s.add("lexical_cast/round_trip/unsigned", [](std::size_t iterations)
+    {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto str = lexical_cast<std::string>(static_cast<unsigned>(i));
+            keep(lexical_cast<unsigned>(str));
+        }
+    });
+
+    s.add("lexical_cast/round_trip/float", [](std::size_t iterations)
+    {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto str = lexical_cast<std::string>(i * 0.25f);
+            keep(lexical_cast<float>(str));
+        }
+    });
+
+    s.add("lexical_cast/round_trip/bool", [](std::size_t iterations)
+    {
+        for (std::size_t i = 0; i < iterations; ++i) {
+            auto str = lexical_cast<std::string>(i % 2 == 0);
+            keep(lexical_cast<bool>(str));
+        }
+    });
+
+    s.add("path/join_path", [](std::size_t iterations)
+    {
+        std::vector<std::string> parts{"/Applications/Blip.app/Contents/",
+            "/Resources/", "Images", "/Sprites/", "player.png"};
+        for (std::size_t i = 0; i < iterations; ++i) {
+            keep(join_path(parts));
+        }
+    });
+
+    s.add("path/split_path", [](std::size_t iterations)
+    {
+        std::string path{
+            "/Applications/Blip.app/Contents/Resources/Images/player.png"};
+        for (std::size_t i = 0; i < iterations; ++i) {
+            keep(split_path(path));
+        }
+    });
+}
+
+}
+
+}
@@ -0,0 +1,183 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+#include "blip/file_watcher.hpp"
+#include "blip/path.hpp"
+#include "blip/trace.hpp"
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <dirent.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// \brief Events watched in each directory
+///
+/// Files are reported once closed after writing, or once moved into place,
+/// as editors often save through a temporary file. Created directories are
+/// watched in turn.
+constexpr std::uint32_t watch_mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+}
+
+namespace blip {
+
+/// \brief inotify instance and the thread reading its events
+struct file_watcher::platform_type
+{
+    int fd{-1}; //!< inotify instance
+
+    /// \brief Pipe written to in order to stop the thread
+    std::array<int, 2> stop{{-1, -1}};
+
+    std::mutex mutex; //!< Mutex guarding the directories
+
+    /// \brief Watched directories by watch descriptor
+    std::map<int, std::string> directories;
+
+    std::thread thread; //!< Thread reading events
+
+    /// \brief Initializes a new instance of the \ref platform_type
+    /// structure
+    platform_type()
+    {
+        fd = inotify_init1(IN_CLOEXEC);
+        if (pipe(stop.data()) != 0) {
+            stop = {{-1, -1}};
+        }
+    }
+
+    /// \brief Destructs the \ref platform_type instance, stopping the thread
+    ~platform_type()
+    {
+        if (thread.joinable()) {
+            char byte{0};
+            while (write(stop[1], &byte, 1) < 0 && errno == EINTR) {
+            }
+            thread.join();
+        }
+        for (auto descriptor : {fd, stop[0], stop[1]}) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+    }
+
+    /// \brief Gets a value indicating whether the instance can watch
+    /// \return whether the inotify instance and the pipe were created
+    bool is_open() const noexcept { return fd >= 0 && stop[0] >= 0; }
+
+    /// \brief Watches a directory and its subdirectories
+    /// \param path path to the directory
+    /// \return whether the directory is watched
+    bool add(std::string const& path)
+    {
+        auto wd = inotify_add_watch(fd, path.c_str(), watch_mask | IN_ONLYDIR);
+        if (wd < 0) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            directories[wd] = path;
+        }
+
+        auto dir = opendir(path.c_str());
+        if (dir == nullptr) {
+            return true;
+        }
+        while (auto entry = readdir(dir)) {
+            std::string name{entry->d_name};
+            if (name == "." || name == "..") {
+                continue;
+            }
+            auto subpath = join_path({path, name});
+            struct stat st;
+            if (stat(subpath.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+                add(subpath);
+            }
+        }
+        closedir(dir);
+        return true;
+    }
+
+    /// \brief Reads events until stopped, recording changes
+    /// \param watcher watcher to record changes in
+    void run(file_watcher& watcher)
+    {
+        trace_thread_name("File events");
+
+        // Events are aligned as the kernel writes them
+        alignas(inotify_event) char buffer[4096];
+        std::array<pollfd, 2> fds{{{fd, POLLIN, 0}, {stop[0], POLLIN, 0}}};
+        while (true) {
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return;
+            }
+            if (fds[1].revents != 0) {
+                return;
+            }
+
+            auto length = read(fd, buffer, sizeof buffer);
+            for (auto p = buffer; length > 0 && p < buffer + length;) {
+                auto event = reinterpret_cast<inotify_event const*>(p);
+                p += sizeof(inotify_event) + event->len;
+
+                std::string directory;
+                {
+                    std::lock_guard<std::mutex> lock{mutex};
+                    auto iter = directories.find(event->wd);
+                    if (iter == std::end(directories)) {
+                        continue;
+                    }
+                    if ((event->mask & IN_IGNORED) != 0) {
+                        directories.erase(iter);
+                        continue;
+                    }
+                    directory = iter->second;
+                }
+                if (event->len == 0) {
+                    continue;
+                }
+
+                auto path = join_path({directory, event->name});
+                if ((event->mask & IN_ISDIR) == 0) {
+                    if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                        watcher.changed(path);
+                    }
+                }
+                else if (add(path)) {
+                    // Files may have been written, or moved in with the
+                    // directory, before it was watched
+                    for (auto&& file : list_files(path)) {
+                        watcher.changed(join_path({path, file}));
+                    }
+                }
+            }
+        }
+    }
+};
+
+bool file_watcher::watch(std::string const& path)
+{
+    if (_platform != nullptr) {
+        return _platform->add(path);
+    }
+
+    auto platform = std::make_shared<platform_type>();
+    if (!platform->is_open() || !platform->add(path)) {
+        return false;
+    }
+    platform->thread = std::thread{&platform_type::run, platform.get(),
+        std::ref(*this)};
+    _platform = std::move(platform);
+    return true;
+}
+
+}
@@ -0,0 +1,133 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+#include "blip/path.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <dirent.h>
+#include <pwd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/// \brief Finds the resources path
+/// \return resources path
+///
+/// Resources are installed alongside the executable.
+std::string find_resources_path()
+{
+    std::string path;
+    ssize_t size;
+    do {
+        path.resize(path.size() + 256);
+        size = readlink("/proc/self/exe", &path[0], path.size());
+        if (size < 0) {
+            throw std::runtime_error{"unable to find system resources path"};
+        }
+    } while (static_cast<std::size_t>(size) == path.size());
+    path.resize(static_cast<std::size_t>(size));
+    return path.substr(0, path.find_last_of('/'));
+}
+
+/// \brief Finds the preferences path
+/// \return preferences path
+std::string find_preferences_path()
+{
+    auto config_home = std::getenv("XDG_CONFIG_HOME");
+    if (config_home != nullptr && config_home[0] == '/') {
+        return config_home;
+    }
+
+    auto home = std::getenv("HOME");
+    if (home == nullptr || home[0] == '\0') {
+        auto pw = getpwuid(getuid());
+        if (pw == nullptr || pw->pw_dir == nullptr) {
+            throw std::runtime_error{
+                "unable to find system preferences path"};
+        }
+        home = pw->pw_dir;
+    }
+    return blip::join_path({home, ".config"});
+}
+
+/// \brief Lists the files in a directory and its subdirectories
+/// \param root path to the listed directory
+/// \param relative path of the directory to read, relative to \p root
+/// \param files where to append the paths of the files, relative to
+/// \p root
+void list_files(
+    std::string const& root,
+    std::string const& relative,
+    std::vector<std::string>& files)
+{
+    auto dir = opendir(blip::join_path({root, relative}).c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    while (auto entry = readdir(dir)) {
+        std::string name{entry->d_name};
+        if (name == "." || name == "..") {
+            continue;
+        }
+        auto path = relative.empty()
+            ? name
+            : blip::join_path({relative, name});
+        struct stat st;
+        if (stat(blip::join_path({root, path}).c_str(), &st) != 0) {
+            continue;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            list_files(root, path, files);
+        }
+        else if (S_ISREG(st.st_mode)) {
+            files.emplace_back(std::move(path));
+        }
+    }
+    closedir(dir);
+}
+
+}
+
+namespace blip {
+
+char const native_path_separator = '/';
+char const* path_separators = "/";
+
+std::string find_system_path(system_path sys_path)
+{
+    switch (sys_path) {
+        case system_path::resources_path:
+            return find_resources_path();
+
+        case system_path::preferences_path:
+            return find_preferences_path();
+    }
+    throw std::invalid_argument{"unknown system path"};
+}
+
+bool create_directory(std::string const& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        auto pos = path.find_last_of(path_separators);
+        if (pos != std::string::npos && pos != 0) {
+            if (!create_directory(path.substr(0, pos))) {
+                return false;
+            }
+        }
+
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+    }
+    return S_ISDIR(st.st_mode);
+}
+
+std::vector<std::string> list_files(std::string const& path)
+{
+    std::vector<std::string> files;
+    ::list_files(path, {}, files);
+    return files;
+}
+
+}
@@ -0,0 +1,122 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+#include "blip/file_watcher.hpp"
+#include "blip/path.hpp"
+#include "blip/trace.hpp"
+#include <set>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+
+namespace {
+
+/// \brief Interval between polls of the watched files
+constexpr std::chrono::milliseconds poll_interval{500};
+
+/// \brief Type of file modification time
+using modified_type = std::pair<long, long>;
+
+}
+
+namespace blip {
+
+/// \brief Watched directory trees and the thread polling them
+struct file_watcher::platform_type
+{
+    std::mutex mutex; //!< Mutex guarding the directories and the stop flag
+    std::condition_variable wake; //!< Wakes the thread to stop
+    bool should_stop{false}; //!< Whether the thread should stop
+
+    /// \brief Paths to the watched directories
+    std::vector<std::string> directories;
+
+    std::thread thread; //!< Thread polling the files
+
+    /// \brief Destructs the \ref platform_type instance, stopping the thread
+    ~platform_type()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            should_stop = true;
+        }
+        wake.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    /// \brief Watches a directory and its subdirectories
+    /// \param path path to the directory
+    /// \return whether the directory is watched
+    bool add(std::string const& path)
+    {
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock{mutex};
+        directories.emplace_back(path);
+        return true;
+    }
+
+    /// \brief Polls the files until stopped, recording changes to their
+    /// modification times
+    /// \param watcher watcher to record changes in
+    void run(file_watcher& watcher)
+    {
+        trace_thread_name("File events");
+
+        // Files found by the first poll of a directory are not changes
+        std::set<std::string> polled;
+        std::map<std::string, modified_type> times;
+        std::unique_lock<std::mutex> lock{mutex};
+        while (!should_stop) {
+            auto paths = directories;
+            lock.unlock();
+            for (auto&& directory : paths) {
+                auto is_first = polled.insert(directory).second;
+                for (auto&& file : list_files(directory)) {
+                    auto path = join_path({directory, file});
+                    struct stat st;
+                    if (stat(path.c_str(), &st) != 0) {
+                        continue;
+                    }
+                    modified_type modified{st.st_mtimespec.tv_sec,
+                        st.st_mtimespec.tv_nsec};
+                    auto iter = times.find(path);
+                    if (iter == std::end(times)) {
+                        times.emplace(path, modified);
+                        if (!is_first) {
+                            watcher.changed(path);
+                        }
+                    }
+                    else if (iter->second != modified) {
+                        iter->second = modified;
+                        watcher.changed(path);
+                    }
+                }
+            }
+            lock.lock();
+            wake.wait_for(lock, poll_interval, [this] { return should_stop; });
+        }
+    }
+};
+
+bool file_watcher::watch(std::string const& path)
+{
+    if (_platform != nullptr) {
+        return _platform->add(path);
+    }
+
+    auto platform = std::make_shared<platform_type>();
+    if (!platform->add(path)) {
+        return false;
+    }
+    platform->thread = std::thread{&platform_type::run, platform.get(),
+        std::ref(*this)};
+    _platform = std::move(platform);
+    return true;
+}
+
+}
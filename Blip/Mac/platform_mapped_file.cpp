@@ -0,0 +1,44 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+#include "blip/mapped_file.hpp"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace blip {
+
+mapped_file::mapped_file(std::string const& path)
+{
+    auto fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error{"unable to open file for mapping"};
+    }
+
+    // The mapping remains valid once the descriptor is closed
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        _size = static_cast<std::size_t>(st.st_size);
+        data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        _size = 0;
+        throw std::runtime_error{"unable to map file"};
+    }
+    _data = static_cast<char const*>(data);
+}
+
+void mapped_file::close() noexcept
+{
+    if (_data != nullptr) {
+        munmap(const_cast<char*>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+}
@@ -51,4 +51,18 @@ bool create_directory(std::string const& path)
         withIntermediateDirectories:YES attributes:nil error:nil];
 }
 
+std::vector<std::string> list_files(std::string const& path)
+{
+    std::vector<std::string> files;
+    auto root = [NSString stringWithUTF8String:path.c_str()];
+    auto enumerator = [[NSFileManager defaultManager] enumeratorAtPath:root];
+    for (NSString* relative in enumerator) {
+        auto type = [[enumerator fileAttributes] fileType];
+        if ([type isEqualToString:NSFileTypeRegular]) {
+            files.emplace_back([relative UTF8String]);
+        }
+    }
+    return files;
+}
+
 }
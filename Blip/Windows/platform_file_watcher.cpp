@@ -0,0 +1,159 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+#include "blip/file_watcher.hpp"
+#include "blip/path.hpp"
+#include "blip/string.hpp"
+#include "blip/trace.hpp"
+#include <list>
+#include <windows.h>
+
+namespace {
+
+/// \brief Changes watched in each directory tree
+constexpr DWORD watch_filter =
+    FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+}
+
+namespace blip {
+
+/// \brief Watched directory trees, each read by its own thread
+struct file_watcher::platform_type
+{
+    /// \brief Watched directory tree
+    struct directory_type
+    {
+        std::string path; //!< Path to the directory
+        HANDLE handle{INVALID_HANDLE_VALUE}; //!< Handle to the directory
+        std::thread thread; //!< Thread reading changes
+    };
+
+    /// \brief Event signalled to stop the threads
+    HANDLE stop{CreateEventA(nullptr, TRUE, FALSE, nullptr)};
+
+    /// \brief Watched directories, listed so that they are never moved
+    std::list<directory_type> directories;
+
+    /// \brief Destructs the \ref platform_type instance, stopping the
+    /// threads
+    ~platform_type()
+    {
+        if (stop != nullptr) {
+            SetEvent(stop);
+        }
+        for (auto&& directory : directories) {
+            directory.thread.join();
+            CloseHandle(directory.handle);
+        }
+        if (stop != nullptr) {
+            CloseHandle(stop);
+        }
+    }
+
+    /// \brief Watches a directory and its subdirectories
+    /// \param path path to the directory
+    /// \param watcher watcher to record changes in
+    /// \return whether the directory is watched
+    bool add(std::string const& path, file_watcher& watcher)
+    {
+        if (stop == nullptr) {
+            return false;
+        }
+        auto handle = CreateFileA(path.c_str(), FILE_LIST_DIRECTORY,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+            OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+            nullptr);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        directories.emplace_back();
+        auto& directory = directories.back();
+        directory.path = path;
+        directory.handle = handle;
+        directory.thread = std::thread{&platform_type::run, this,
+            std::ref(directory), std::ref(watcher)};
+        return true;
+    }
+
+    /// \brief Reads changes to a directory tree until stopped, recording
+    /// them
+    /// \param directory directory to read
+    /// \param watcher watcher to record changes in
+    void run(directory_type& directory, file_watcher& watcher)
+    {
+        trace_thread_name("File events");
+
+        // Notifications are aligned to double words
+        alignas(DWORD) char buffer[16384];
+        OVERLAPPED overlapped{};
+        overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        if (overlapped.hEvent == nullptr) {
+            return;
+        }
+
+        HANDLE events[] = {stop, overlapped.hEvent};
+        DWORD length;
+        while (true) {
+            ResetEvent(overlapped.hEvent);
+            if (!ReadDirectoryChangesW(directory.handle, buffer,
+                sizeof buffer, TRUE, watch_filter, nullptr, &overlapped,
+                nullptr))
+            {
+                break;
+            }
+            if (WaitForMultipleObjects(2, events, FALSE, INFINITE)
+                != WAIT_OBJECT_0 + 1)
+            {
+                // The read is cancelled and waited for, as it writes to
+                // the buffer
+                CancelIo(directory.handle);
+                GetOverlappedResult(directory.handle, &overlapped, &length,
+                    TRUE);
+                break;
+            }
+            if (!GetOverlappedResult(directory.handle, &overlapped, &length,
+                FALSE))
+            {
+                break;
+            }
+
+            // A length of zero means that the changes did not fit in the
+            // buffer, and are lost
+            for (DWORD offset = 0; length > 0;) {
+                auto info = reinterpret_cast<FILE_NOTIFY_INFORMATION const*>(
+                    buffer + offset);
+                if (info->Action == FILE_ACTION_ADDED
+                    || info->Action == FILE_ACTION_MODIFIED
+                    || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+                {
+                    std::wstring name(info->FileName,
+                        info->FileNameLength / sizeof(WCHAR));
+                    auto path = join_path({directory.path, narrow(name)});
+                    auto attributes = GetFileAttributesA(path.c_str());
+                    if (attributes != INVALID_FILE_ATTRIBUTES
+                        && (attributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+                    {
+                        watcher.changed(path);
+                    }
+                }
+                if (info->NextEntryOffset == 0) {
+                    break;
+                }
+                offset += info->NextEntryOffset;
+            }
+        }
+        CloseHandle(overlapped.hEvent);
+    }
+};
+
+bool file_watcher::watch(std::string const& path)
+{
+    if (_platform == nullptr) {
+        _platform = std::make_shared<platform_type>();
+    }
+    return _platform->add(path, *this);
+}
+
+}
@@ -0,0 +1,47 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+#include "blip/mapped_file.hpp"
+#include <stdexcept>
+#include <windows.h>
+
+namespace blip {
+
+mapped_file::mapped_file(std::string const& path)
+{
+    auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error{"unable to open file for mapping"};
+    }
+
+    // The view remains valid once the file and mapping handles are closed
+    LARGE_INTEGER size;
+    void* data = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+            nullptr);
+        if (mapping != nullptr) {
+            _size = static_cast<std::size_t>(size.QuadPart);
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    if (data == nullptr) {
+        _size = 0;
+        throw std::runtime_error{"unable to map file"};
+    }
+    _data = static_cast<char const*>(data);
+}
+
+void mapped_file::close() noexcept
+{
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+}
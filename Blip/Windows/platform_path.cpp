@@ -42,6 +42,38 @@ std::string find_preferences_path()
     return narrow(std::wstring{path});
 }
 
+/// \brief Lists the files in a directory and its subdirectories
+/// \param root path to the listed directory
+/// \param relative path of the directory to read, relative to \p root
+/// \param files where to append the paths of the files, relative to
+/// \p root
+void list_files(
+    std::string const& root,
+    std::string const& relative,
+    std::vector<std::string>& files)
+{
+    WIN32_FIND_DATAA data;
+    auto pattern = join_path({root, relative, "*"});
+    auto find = FindFirstFileA(pattern.c_str(), &data);
+    if (find == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    do {
+        std::string name{data.cFileName};
+        if (name == "." || name == "..") {
+            continue;
+        }
+        auto path = relative.empty() ? name : join_path({relative, name});
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            list_files(root, path, files);
+        }
+        else {
+            files.emplace_back(std::move(path));
+        }
+    } while (FindNextFileA(find, &data));
+    FindClose(find);
+}
+
 }
 
 namespace blip {
@@ -77,4 +109,11 @@ bool create_directory(std::string const& path)
         || (attr & FILE_ATTRIBUTE_REPARSE_POINT);
 }
 
+std::vector<std::string> list_files(std::string const& path)
+{
+    std::vector<std::string> files;
+    ::list_files(path, {}, files);
+    return files;
+}
+
 }
@@ -6,8 +6,14 @@
 /// \ingroup application
 
 #include "blip/application.hpp"
+#include "blip/coalesce.hpp"
 #include "blip/main_menu_state.hpp"
 #include "blip/path.hpp"
+#include "blip/recording_event_source.hpp"
+#include "blip/resource_size.hpp"
+#include "blip/synthetic_event_source.hpp"
+#include "blip/trace.hpp"
+#include "blip/window_event_source.hpp"
 #include "blip/xml_deserializer.hpp"
 #include "blip/xml_serializer.hpp"
 #include <SFML/Audio/SoundBuffer.hpp>
@@ -16,17 +22,84 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/System/Clock.hpp>
 #include <SFML/Window/Event.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <thread>
+
+namespace {
+
+/// \brief Number of bytes in a kibibyte, the unit of retention budgets
+constexpr std::size_t kibibyte = 1024;
+
+/// \brief Loads a resource from the resource archive, or from its loose file
+/// if it is not packed
+/// \tparam T type of resource
+/// \param mgr resource manager to load from
+/// \param resource resource to load into
+/// \param path resource path
+/// \return whether the resource was loaded
+template <typename T>
+bool load_resource(
+    blip::resource_manager const& mgr,
+    T& resource,
+    std::string const& path)
+{
+    auto blob = mgr.archive().find(path);
+    if (blob.data != nullptr) {
+        return resource.loadFromMemory(blob.data, blob.size);
+    }
+    return resource.loadFromFile(mgr.path_to(path));
+}
+
+/// \brief Sets the retention policy of a resource cache, if it exists
+/// \tparam T type of resource
+/// \param mgr resource manager holding the cache
+/// \param budget retention budget in kibibytes
+/// \param estimator resource size estimator
+template <typename T>
+void set_retention(
+    blip::resource_manager& mgr,
+    unsigned budget,
+    typename blip::typed_resource_cache<T>::size_estimator_type estimator)
+{
+    auto cache = mgr.cache_for<T>();
+    if (cache == nullptr) {
+        return;
+    }
+    cache->size_estimator(std::move(estimator));
+    cache->retention_budget(budget * kibibyte);
+}
+
+}
 
 namespace blip {
 
-application::application()
-    : _resource_mgr{join_path({
+application::application(application_mode mode)
+    : _mode{mode}
+    , _resource_mgr{join_path({
         find_system_path(system_path::resources_path), "Resources"})}
 {
+    load_resource_archive();
     add_resource_caches();
     load_input_spec();
     load_config();
+    set_resource_retention();
+    start_hot_reload();
+    _texture_uploader.budget(_config.texture_upload_budget);
+    _state_mgr.profiler(&_profiler);
+    _state_mgr.resources(&_resource_mgr);
+
+    if (_mode == application_mode::headless) {
+        _events = std::make_unique<synthetic_event_source>();
+        return;
+    }
 
     sf::VideoMode video_mode{_config.width, _config.height, _config.depth};
     auto window_style = _config.is_full_screen
@@ -36,11 +109,17 @@ application::application()
     context_settings.antialiasingLevel = _config.antialiasing_level;
     _window.create(video_mode, product, window_style, context_settings);
     _window.setVerticalSyncEnabled(_config.use_vertical_sync);
+    _pacer.frame_rate(_config.frame_rate_limit);
+    _events = std::make_unique<window_event_source>(_window);
 }
 
 application::~application()
 {
-    save_config();
+    _file_watcher.reset();
+    stop_trace();
+    if (_mode != application_mode::headless) {
+        save_config();
+    }
 }
 
 void application::exit(int exit_code) noexcept
@@ -49,35 +128,133 @@ void application::exit(int exit_code) noexcept
     _exit_code = exit_code;
 }
 
-int application::run()
+void application::events(std::unique_ptr<event_source> events)
+{
+    if (events == nullptr) {
+        throw std::invalid_argument{"event source must not be null"};
+    }
+    _events = std::move(events);
+}
+
+void application::record_events(std::string const& path)
+{
+    _events = std::make_unique<recording_event_source>(
+        std::move(_events), path);
+}
+
+int application::run(std::size_t frame_limit)
 {
     _state_mgr.push_back(std::make_unique<main_menu_state>(*this));
 
     sf::Clock frame_clock;
     float time_step{0.0f};
 
+    // Headless frames advance by a fixed step so that runs are repeatable
+    // and are not limited by real time
+    auto is_headless = _mode == application_mode::headless;
+    auto headless_time_step = 1.0f / (_config.tick_rate > 0
+        ? _config.tick_rate
+        : 60u);
+    std::size_t frame_count{0};
+
+    trace_thread_name("Main");
+
     _is_running = true;
     while (_is_running) {
-        _state_mgr.work();
+        trace_scope frame_trace{"Frame"};
+        _profiler.begin_frame();
+        {
+            trace_scope trace{"Work"};
+            profile_scope scope{&_profiler, profile_phase::work};
+            _state_mgr.work();
+            if (!is_headless) {
+                _texture_uploader.update();
+            }
+            if (_file_watcher != nullptr) {
+                reload_changed();
+            }
+        }
 
         // After working on the state manager, we must lock in order to
         // perform notifications/updates/draws
         std::lock_guard<decltype(_state_mgr.mutex)> lock{_state_mgr.mutex};
-        
-        sf::Event event;
-        while (_window.pollEvent(event)) {
-            notify(event);
+
+        {
+            trace_scope trace{"Notify"};
+            profile_scope scope{&_profiler, profile_phase::notify};
+            _input_state.begin_frame();
+            time_step = _events->time_step(time_step);
+            _events->next_frame();
+            _timed_input_events.clear();
+            _input_map.update(time_step, _timed_input_events);
+            for (auto&& e : _timed_input_events) {
+                _input_state.apply(e);
+            }
+            _frame_events.clear();
+            sf::Event event;
+            while (_events->poll(event)) {
+                _frame_events.emplace_back(event);
+            }
+            if (!_state_mgr.needs_every_sample()) {
+                coalesce_joystick_moves(_frame_events);
+            }
+            for (auto&& e : _frame_events) {
+                notify(e);
+            }
+            _input_state.update(time_step);
+            if (_events->is_finished()) {
+                exit();
+            }
         }
-        update(time_step);
-        draw();
 
-        time_step = frame_clock.restart().asSeconds();
+        auto alpha = 1.0f;
+        {
+            trace_scope trace{"Update"};
+            profile_scope scope{&_profiler, profile_phase::update};
+            if (_config.use_fixed_time_step && _config.tick_rate > 0) {
+                alpha = update_fixed(time_step);
+            }
+            else {
+                update(time_step);
+            }
+        }
+        {
+            trace_scope trace{"Draw"};
+            profile_scope scope{&_profiler, profile_phase::draw};
+            draw(alpha);
+        }
+        {
+            trace_scope trace{"Wait"};
+            profile_scope scope{&_profiler, profile_phase::wait};
+            _pacer.wait();
+        }
+        _profiler.end_frame();
+
+        time_step = is_headless
+            ? headless_time_step
+            : frame_clock.restart().asSeconds();
+        if (frame_limit > 0 && ++frame_count == frame_limit) {
+            exit();
+        }
     }
     return _exit_code;
 }
 
 void application::notify(sf::Event const& event)
 {
+    // An input captured for rebinding is consumed by the input map
+    if (_input_map.capture(event)) {
+        return;
+    }
+
+    // The bindings are advanced here, once, so states read the events
+    // mapped from it through input_events rather than mapping it again
+    _input_events.clear();
+    _input_map.map(event, _input_events);
+    for (auto&& e : _input_events) {
+        _input_state.apply(e);
+    }
+
     if (_state_mgr.notify(event)) {
         return;
     }
@@ -97,29 +274,69 @@ void application::update(float time_step)
     _state_mgr.update(time_step);
 }
 
-void application::draw()
+float application::update_fixed(float time_step)
+{
+    auto tick = 1.0f / _config.tick_rate;
+    auto max_ticks = std::max(_config.max_ticks_per_frame, 1u);
+
+    _time_accumulator += time_step;
+    for (auto ticks = 0u; _time_accumulator >= tick; ++ticks) {
+        if (ticks == max_ticks) {
+            // Too far behind to catch up; drop the backlog but keep the
+            // partial step so that interpolation stays continuous
+            _time_accumulator = std::fmod(_time_accumulator, tick);
+            break;
+        }
+        update(tick);
+        _time_accumulator -= tick;
+    }
+    return _time_accumulator / tick;
+}
+
+void application::draw(float alpha)
 {
+    _state_mgr.interpolate(alpha);
+    if (_mode == application_mode::headless) {
+        return;
+    }
+
     _window.clear();
     _window.draw(_state_mgr);
     _window.display();
 }
 
+void application::load_resource_archive()
+{
+    // Resources are loaded from loose files when no archive is installed
+    auto path = join_path({find_system_path(system_path::resources_path),
+        resource_archive_name});
+    if (file_size(path) == 0) {
+        return;
+    }
+
+    trace_scope trace{"Load resource archive"};
+    _resource_mgr.archive(resource_archive{path});
+}
+
 void application::add_resource_caches()
 {
-    using sound_buffer_cache_type = typed_resource_cache<sf::SoundBuffer>;
-    _resource_mgr.add_cache<sound_buffer_cache_type::resource_type>(
-        std::make_unique<sound_buffer_cache_type>([this](
-            sound_buffer_cache_type::name_type const& name)
-                -> sound_buffer_cache_type::ptr_type
-        {
-            auto ptr =
-                std::make_shared<sound_buffer_cache_type::resource_type>();
-            auto path = _resource_mgr.path_to(join_path({"Sounds", name}));
-            if (!ptr->loadFromFile(path)) {
-                return nullptr;
-            }
-            return ptr;
-        }));
+    // Sound buffers require an audio device
+    if (_mode != application_mode::headless) {
+        using sound_buffer_cache_type = typed_resource_cache<sf::SoundBuffer>;
+        _resource_mgr.add_cache<sound_buffer_cache_type::resource_type>(
+            std::make_unique<sound_buffer_cache_type>([this](
+                sound_buffer_cache_type::name_type const& name)
+                    -> sound_buffer_cache_type::ptr_type
+            {
+                auto ptr =
+                    std::make_shared<sound_buffer_cache_type::resource_type>();
+                auto path = join_path({"Sounds", name});
+                if (!load_resource(_resource_mgr, *ptr, path)) {
+                    return nullptr;
+                }
+                return ptr;
+            }));
+    }
 
     using font_cache_type = typed_resource_cache<sf::Font>;
     _resource_mgr.add_cache<font_cache_type::resource_type>(
@@ -129,8 +346,8 @@ void application::add_resource_caches()
         {
             auto ptr =
                 std::make_shared<font_cache_type::resource_type>();
-            auto path = _resource_mgr.path_to(join_path({"Fonts", name}));
-            if (!ptr->loadFromFile(path)) {
+            auto path = join_path({"Fonts", name});
+            if (!load_resource(_resource_mgr, *ptr, path)) {
                 return nullptr;
             }
             return ptr;
@@ -144,35 +361,117 @@ void application::add_resource_caches()
         {
             auto ptr =
                 std::make_shared<image_cache_type::resource_type>();
-            auto path = _resource_mgr.path_to(join_path({"Images", name}));
-            if (!ptr->loadFromFile(path)) {
+            auto path = join_path({"Images", name});
+            if (!load_resource(_resource_mgr, *ptr, path)) {
                 return nullptr;
             }
             return ptr;
         }));
 
-    using texture_cache_type = typed_resource_cache<sf::Texture>;
-    _resource_mgr.add_cache<texture_cache_type::resource_type>(
-        std::make_unique<texture_cache_type>([this](
-            texture_cache_type::name_type const& name)
-                -> texture_cache_type::ptr_type
+    // Textures require a renderer. Textures loaded asynchronously are
+    // decoded as images on the workers and uploaded by the main thread
+    // within the per-frame budget.
+    if (_mode != application_mode::headless) {
+        using texture_cache_type = typed_resource_cache<sf::Texture>;
+        _resource_mgr.add_cache<texture_cache_type::resource_type>(
+            std::make_unique<texture_cache_type>([this](
+                texture_cache_type::name_type const& name)
+                    -> texture_cache_type::ptr_type
+            {
+                auto ptr =
+                    std::make_shared<texture_cache_type::resource_type>();
+                auto path = join_path({"Images", name});
+                if (!load_resource(_resource_mgr, *ptr, path)) {
+                    return nullptr;
+                }
+                return ptr;
+            },
+            [this](
+                texture_cache_type::name_type const& name,
+                worker_pool& workers)
+                    -> texture_cache_type::future_type
+            {
+                auto images = _resource_mgr.cache_for<sf::Image>();
+                return _texture_uploader.upload(
+                    images->get_async(name, workers));
+            }));
+
+        // Textures loaded asynchronously are only uploaded by the thread
+        // running the application, which constructs it, so that thread
+        // must not wait for them
+        _resource_mgr.cache_for<sf::Texture>()->async_thread(
+            std::this_thread::get_id());
+
+        // Reloaded textures are uploaded within the budget too. Their
+        // images are decoded anew, since the image cache may not have
+        // reloaded them yet.
+        _resource_mgr.cache_for<sf::Texture>()->async_reloader([this](
+            texture_cache_type::name_type const& name,
+            worker_pool& workers)
+                -> texture_cache_type::future_type
         {
-            auto ptr =
-                std::make_shared<texture_cache_type::resource_type>();
-            auto path = _resource_mgr.path_to(join_path({"Images", name}));
-            if (!ptr->loadFromFile(path)) {
-                return nullptr;
-            }
-            return ptr;
-        }));
+            using image_ptr = texture_uploader::image_ptr;
+            auto image = std::make_shared<std::promise<image_ptr>>();
+            workers.submit([this, name, image]
+            {
+                try {
+                    trace_scope trace{"Reload resource", name.c_str()};
+                    auto ptr = std::make_shared<sf::Image>();
+                    auto path = join_path({"Images", name});
+                    if (!load_resource(_resource_mgr, *ptr, path)) {
+                        ptr = nullptr;
+                    }
+                    image->set_value(std::move(ptr));
+                }
+                catch (...) {
+                    image->set_exception(std::current_exception());
+                }
+            });
+            return _texture_uploader.upload(image->get_future().share());
+        });
+    }
+}
+
+void application::set_resource_retention()
+{
+    set_retention<sf::SoundBuffer>(_resource_mgr,
+        _config.sound_buffer_retention_budget,
+        [](std::string const&, sf::SoundBuffer const& buffer)
+        {
+            return resource_size(buffer);
+        });
+
+    // Font faces are read from their files as glyphs are needed, so the
+    // file size stands in for the memory used
+    set_retention<sf::Font>(_resource_mgr, _config.font_retention_budget,
+        [this](std::string const& name, sf::Font const&)
+        {
+            auto path = join_path({"Fonts", name});
+            auto blob = _resource_mgr.archive().find(path);
+            return blob.data != nullptr
+                ? blob.size
+                : file_size(_resource_mgr.path_to(path));
+        });
+
+    set_retention<sf::Image>(_resource_mgr, _config.image_retention_budget,
+        [](std::string const&, sf::Image const& image)
+        {
+            return resource_size(image);
+        });
+    set_retention<sf::Texture>(_resource_mgr,
+        _config.texture_retention_budget,
+        [](std::string const&, sf::Texture const& texture)
+        {
+            return resource_size(texture);
+        });
 }
 
 void application::load_input_spec()
 {
+    trace_scope trace{"Load input specification"};
     pugi::xml_document doc;
-    auto path = _resource_mgr.path_to(join_path(
-        {"Configurations", "InputSpecification.xml"}));
-    if (!doc.load_file(path.c_str())) {
+    auto path = join_path({"Configurations", "InputSpecification.xml"});
+    if (!_resource_mgr.load_document(path, doc)) {
         throw std::runtime_error{"unable to load input specification"};
     }
 
@@ -180,10 +479,12 @@ void application::load_input_spec()
     if (!dx.child("InputSpecification", _input_spec)) {
         throw std::runtime_error{"unable to load input specification"};
     }
+    _input_state.reset(_input_spec);
 }
 
 void application::load_config()
 {
+    trace_scope trace{"Load configuration"};
     _config_path = join_path({find_system_path(system_path::preferences_path),
         company, product});
     if (!create_directory(_config_path)) {
@@ -191,35 +492,168 @@ void application::load_config()
     }
     _config_path = join_path({_config_path, "Application.xml"});
 
+    read_config(_config, _input_map);
+    if (_input_map.contexts.empty()) {
+        throw std::runtime_error{"unable to load input map"};
+    }
+}
+
+bool application::read_config(
+    configuration& config,
+    struct input_map& map) const
+{
     pugi::xml_document doc;
-    if (doc.load_file(_config_path.c_str())) {
+    auto result = doc.load_file(_config_path.c_str());
+    if (result) {
         xml_deserializer dx{doc.child("Application")};
         if (dx) {
-            dx.child("Configuration", _config);
-            dx.child("InputMap", _input_map, _input_spec);
+            dx.child("Configuration", config);
+            dx.child("InputMap", map, _input_spec);
         }
     }
 
-    if (_input_map.contexts.empty()) {
-        auto path = _resource_mgr.path_to(join_path(
-            {"Configurations", "InputMap.xml"}));
-        if (doc.load_file(path.c_str())) {
-            xml_deserializer{doc}.child("InputMap", _input_map, _input_spec);
+    if (map.contexts.empty()) {
+        auto path = join_path({"Configurations", "InputMap.xml"});
+        if (_resource_mgr.load_document(path, doc)) {
+            xml_deserializer{doc}.child("InputMap", map, _input_spec);
         }
     }
+    return result || result.status == pugi::status_file_not_found;
+}
 
-    if (_input_map.contexts.empty()) {
-        throw std::runtime_error{"unable to load input map"};
+void application::reload_config()
+{
+    trace_scope trace{"Reload configuration"};
+
+    // Preferences being written, or saved with errors, and input maps that
+    // cannot be read leave the configuration as it is
+    configuration config;
+    struct input_map map;
+    if (!read_config(config, map) || map.contexts.empty()) {
+        return;
+    }
+    _config = config;
+
+    // Bindings changed at runtime are kept until they are saved, and
+    // actions held under the replaced bindings are released
+    if (!_input_map.is_dirty()) {
+        _input_map = std::move(map);
+        _input_state.reset(_input_spec);
+    }
+
+    // The window is only created at startup, so changes to its settings
+    // take effect when the application is restarted
+    set_resource_retention();
+    _texture_uploader.budget(_config.texture_upload_budget);
+    if (_mode != application_mode::headless) {
+        _window.setVerticalSyncEnabled(_config.use_vertical_sync);
+        _pacer.frame_rate(_config.frame_rate_limit);
+    }
+}
+
+void application::start_hot_reload()
+{
+    if (!_config.use_hot_reload) {
+        return;
+    }
+
+    _file_watcher = std::make_unique<file_watcher>(
+        [this](std::string const& path)
+        {
+            std::lock_guard<std::mutex> lock{_changed_mutex};
+            _changed_paths.emplace_back(path);
+        },
+        std::chrono::milliseconds{_config.hot_reload_delay});
+
+    // Packed resources are not loaded from their files
+    if (!_resource_mgr.archive().is_open()) {
+        _file_watcher->watch(_resource_mgr.base_path);
+    }
+    _file_watcher->watch(join_path({
+        find_system_path(system_path::preferences_path), company, product}));
+}
+
+void application::reload_changed()
+{
+    std::vector<std::string> paths;
+    {
+        std::lock_guard<std::mutex> lock{_changed_mutex};
+        paths.swap(_changed_paths);
+    }
+    for (auto&& path : paths) {
+        reload_file(path);
+    }
+
+    // Resources reloaded on the workers are replaced once they are ready,
+    // while no state is using them
+    _resource_mgr.apply_reloads();
+}
+
+void application::reload_file(std::string const& path)
+{
+    if (path == _config_path) {
+        reload_config();
+        return;
+    }
+
+    // Resources are named by their paths within the directories of their
+    // types. The base path must end at a separator, so that files in
+    // sibling directories sharing its name as a prefix are not reloaded.
+    auto const& base_path = _resource_mgr.base_path;
+    if (path.size() <= base_path.size()
+        || path.compare(0, base_path.size(), base_path) != 0)
+    {
+        return;
+    }
+    auto is_separator = [](char c)
+    {
+        return std::strchr(path_separators, c) != nullptr;
+    };
+    if (!base_path.empty() && !is_separator(base_path.back())
+        && !is_separator(path[base_path.size()]))
+    {
+        return;
+    }
+    std::vector<std::string> parts;
+    for (auto part : split_path(path.substr(base_path.size()))) {
+        part = trim_path(part);
+        if (!part.empty()) {
+            parts.emplace_back(std::move(part));
+        }
+    }
+    if (parts.size() < 2) {
+        return;
+    }
+    auto directory = parts.front();
+    parts.erase(std::begin(parts));
+    auto name = join_path(parts);
+
+    trace_scope trace{"Reload file", name.c_str()};
+    if (directory == "Configurations" && name == "InputMap.xml") {
+        reload_config();
+    }
+    else if (directory == "Fonts") {
+        _resource_mgr.reload<sf::Font>(name);
+    }
+    else if (directory == "Images") {
+        _resource_mgr.reload<sf::Image>(name);
+        _resource_mgr.reload<sf::Texture>(name);
+    }
+    else if (directory == "Sounds") {
+        // Sounds playing a replaced buffer are stopped and detached from it
+        _resource_mgr.reload<sf::SoundBuffer>(name);
     }
 }
 
-void application::save_config() const
+void application::save_config()
 {
     pugi::xml_document doc;
     xml_serializer sx{doc.append_child("Application")};
     sx.child("Configuration", _config);
     sx.child("InputMap", _input_map);
-    doc.save_file(_config_path.c_str());
+    if (doc.save_file(_config_path.c_str())) {
+        _input_map.is_dirty(false);
+    }
 }
 
 }
@@ -8,17 +8,36 @@
 #pragma once
 
 #include "blip/configuration.hpp"
+#include "blip/event_source.hpp"
+#include "blip/file_watcher.hpp"
+#include "blip/frame_pacer.hpp"
+#include "blip/fixed_vector.hpp"
+#include "blip/frame_profiler.hpp"
 #include "blip/input_map.hpp"
 #include "blip/input_specification.hpp"
+#include "blip/input_state.hpp"
 #include "blip/resource_manager.hpp"
 #include "blip/state_manager.hpp"
+#include "blip/texture_uploader.hpp"
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace blip {
 
 /// \addtogroup application
 /// \{
 
+/// \brief Modes in which the \ref application can run
+enum class application_mode
+{
+    windowed, //!< Runs in a window, drawing and presenting every frame
+    headless, //!< Runs without a window or renderer
+};
+
 /// \brief Encapsulates the application
 class application
 {
@@ -26,8 +45,25 @@ public:
     static constexpr char const* company = "Xettex"; //!< Company name
     static constexpr char const* product = "Blip"; //!< Product name
 
+    /// \brief Name of the resource archive, installed alongside the
+    /// resources directory
+    static constexpr char const* resource_archive_name = "Resources.pack";
+
+    /// \brief Maximum number of input events mapped from a single event
+    static constexpr std::size_t max_input_events = 16;
+
+    /// \brief Type of list of input events mapped from a single event
+    using input_event_list = fixed_vector<input_event, max_input_events>;
+
     /// \brief Initializes a new instance of the \ref application class
-    application();
+    /// \param mode mode to run in
+    ///
+    /// In \ref application_mode::headless, no window is created, resources
+    /// that require a renderer or audio device are unavailable, nothing is
+    /// drawn, every frame advances by a fixed time step without waiting, and
+    /// the configuration is not saved. Events are supplied by an empty
+    /// \ref synthetic_event_source until replaced with \ref events.
+    explicit application(application_mode mode = application_mode::windowed);
 
     /// \brief Deleted copy constructor
     application(application const&) = delete;
@@ -50,9 +86,15 @@ public:
     /// \param exit_code application exit status
     void exit(int exit_code = 0) noexcept;
 
+    /// \brief Gets the mode the application runs in
+    /// \return application mode
+    application_mode mode() const noexcept { return _mode; }
+
     /// \brief Runs the application
+    /// \param frame_limit number of frames to run before exiting, or 0 to
+    /// run until exited
     /// \return application exit status
-    int run();
+    int run(std::size_t frame_limit = 0);
 
     /// \brief Gets a reference to the resource manager
     /// \return resource manager
@@ -68,30 +110,112 @@ public:
 
     /// \brief Gets a reference to the input map
     /// \return input map
-    input_map& input_map() noexcept { return _input_map; }
+    blip::input_map& input_map() noexcept { return _input_map; }
+
+    /// \brief Gets the input events mapped from the event being notified
+    /// \return list of input events
+    ///
+    /// Valid while states are being notified of an event. States read the
+    /// events here, or through \ref input_map::mapped, rather than mapping
+    /// the event again, which would advance the bindings twice. Events
+    /// produced by time passing rather than by an event, such as a mouse
+    /// axis returning to rest, are given by \ref timed_input_events instead.
+    input_event_list const& input_events() const noexcept
+    {
+        return _input_events;
+    }
+
+    /// \brief Gets the input events produced at the start of the frame by
+    /// bindings that depend on time
+    /// \return list of input events
+    ///
+    /// Valid until the next frame starts, so that states can apply them
+    /// when they are updated. They are produced before the events of the
+    /// frame are notified.
+    input_event_list const& timed_input_events() const noexcept
+    {
+        return _timed_input_events;
+    }
+
+    /// \brief Gets a reference to the polled input state
+    /// \return input state
+    ///
+    /// Updated with the input events of each frame before states are
+    /// updated.
+    blip::input_state const& input_state() const noexcept
+    {
+        return _input_state;
+    }
 
     /// \brief Gets a reference to the state manager
     /// \return state manager
     state_manager& state_mgr() noexcept { return _state_mgr; }
 
+    /// \brief Gets a reference to the frame profiler
+    /// \return frame profiler
+    frame_profiler& profiler() noexcept { return _profiler; }
+
     /// \brief Gets a reference to the rendering window
     /// \return rendering window
+    ///
+    /// In \ref application_mode::headless, the window is never opened.
     sf::RenderWindow& window() noexcept { return _window; }
 
+    /// \brief Gets a reference to the event source
+    /// \return event source
+    event_source& events() noexcept { return *_events; }
+
+    /// \brief Replaces the event source
+    /// \param events new event source
+    void events(std::unique_ptr<event_source> events);
+
+    /// \brief Records the events of the current event source to a log
+    /// \param path path to the event log, which is replaced
+    ///
+    /// The log can be replayed with a \ref replay_event_source. Throws
+    /// \ref std::runtime_error if the log cannot be opened.
+    void record_events(std::string const& path);
+
 private:
+    application_mode _mode; //!< Mode the application runs in
     bool _is_running{false}; //!< Whether the application is running
     int _exit_code{0}; //!< Application exit status
 
     resource_manager _resource_mgr; //!< Resource manager
+    texture_uploader _texture_uploader; //!< Texture upload stage
     input_specification _input_spec; //!< Input specification
 
     std::string _config_path; //!< Application configuration file path
     configuration _config; //!< Application configuration
     struct input_map _input_map; //!< Input map
+    input_event_list _input_events; //!< Input events of the current event
+
+    /// \brief Input events produced by time at the start of the frame
+    input_event_list _timed_input_events;
+
+    std::vector<sf::Event> _frame_events; //!< Events of the current frame
+    class input_state _input_state; //!< Polled input state
 
     state_manager _state_mgr; //!< State manager
 
     sf::RenderWindow _window; //!< Rendering window
+    std::unique_ptr<event_source> _events; //!< Event source
+    frame_pacer _pacer; //!< Frame rate limiter
+    frame_profiler _profiler; //!< Frame profiler
+
+    std::mutex _changed_mutex; //!< Mutex guarding the changed files
+
+    /// \brief Paths of the files changed since they were last reloaded
+    std::vector<std::string> _changed_paths;
+
+    /// \brief Watcher for changed files, or null if hot reload is disabled
+    ///
+    /// Declared after the changed files, which it records into, so that it
+    /// is stopped first.
+    std::unique_ptr<file_watcher> _file_watcher;
+
+    /// \brief Time accumulated toward the next fixed update
+    float _time_accumulator{0.0f};
 
     /// \brief Notifies the application of an event
     /// \param event event to notify of
@@ -101,20 +225,65 @@ private:
     /// \param time_step time step to update by
     void update(float time_step);
 
+    /// \brief Updates the application state in fixed time steps
+    /// \param time_step time elapsed since the previous frame
+    /// \return fraction of a fixed time step left over, on [0,1]
+    ///
+    /// Elapsed time is accumulated and consumed in steps of
+    /// \ref configuration::tick_rate. At most
+    /// \ref configuration::max_ticks_per_frame steps are taken per frame;
+    /// any backlog beyond that is dropped so that a slow frame cannot cause
+    /// every following frame to fall further behind.
+    float update_fixed(float time_step);
+
     /// \brief Draws the application scene
-    void draw();
+    /// \param alpha fraction of a fixed time step elapsed since the last
+    /// update, on [0,1]
+    void draw(float alpha);
+
+    /// \brief Opens the resource archive, if one is installed
+    ///
+    /// Throws \ref std::runtime_error if the archive is malformed.
+    void load_resource_archive();
 
     /// \brief Adds caches for common resource types to the resource manager
     void add_resource_caches();
 
+    /// \brief Sets the retention budgets of the resource caches from the
+    /// configuration
+    void set_resource_retention();
+
     /// \brief Loads the input specification
     void load_input_spec();
 
     /// \brief Loads the application configuration
     void load_config();
 
+    /// \brief Reads the application configuration and input map from the
+    /// preferences, falling back to the default input map
+    /// \param config configuration to read into
+    /// \param map input map to read into, which must be empty
+    /// \return whether the preferences were read, or do not exist
+    bool read_config(configuration& config, struct input_map& map) const;
+
+    /// \brief Reloads the application configuration and input map,
+    /// applying the settings that can change while running
+    void reload_config();
+
+    /// \brief Starts watching the resource and preferences directories for
+    /// changed files, if hot reload is enabled
+    void start_hot_reload();
+
+    /// \brief Reloads the resources and configuration files that have
+    /// changed since they were last reloaded
+    void reload_changed();
+
+    /// \brief Reloads a changed resource or configuration file
+    /// \param path full path of the file
+    void reload_file(std::string const& path);
+
     /// \brief Saves the application configuration
-    void save_config() const;
+    void save_config();
 };
 
 /// \}
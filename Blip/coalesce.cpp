@@ -0,0 +1,57 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the event coalescing implementation
+/// \ingroup application
+
+#include "blip/coalesce.hpp"
+#include <SFML/Window/Joystick.hpp>
+#include <array>
+
+namespace blip {
+
+std::size_t coalesce_joystick_moves(std::vector<sf::Event>& events) noexcept
+{
+    constexpr auto axis_count = static_cast<std::size_t>(
+        sf::Joystick::AxisCount);
+    constexpr auto slot_count = sf::Joystick::Count * axis_count;
+
+    // Find the last move of each axis, offset by one so that zero means
+    // the axis did not move
+    std::array<std::size_t, slot_count> last{};
+    auto moves = 0u;
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        auto& e = events[i];
+        if (e.type != sf::Event::JoystickMoved) {
+            continue;
+        }
+        auto slot = e.joystickMove.joystickId * axis_count
+            + static_cast<std::size_t>(e.joystickMove.axis);
+        if (slot < slot_count) {
+            last[slot] = i + 1;
+            ++moves;
+        }
+    }
+    if (moves < 2) {
+        return 0;
+    }
+
+    std::size_t kept{0};
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        auto& e = events[i];
+        if (e.type == sf::Event::JoystickMoved) {
+            auto slot = e.joystickMove.joystickId * axis_count
+                + static_cast<std::size_t>(e.joystickMove.axis);
+            if (slot < slot_count && last[slot] != i + 1) {
+                continue;
+            }
+        }
+        events[kept++] = e;
+    }
+    auto removed = events.size() - kept;
+    events.resize(kept);
+    return removed;
+}
+
+}
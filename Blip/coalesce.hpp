@@ -0,0 +1,30 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the event coalescing interface
+/// \ingroup application
+
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Coalesces the joystick moves within a list of events
+/// \param events events of a single frame, in order
+/// \return number of events removed
+///
+/// Only the last move of each joystick axis is kept, in its original
+/// position relative to the other events, since each move reports the
+/// absolute position of the axis. Every other event is kept in order.
+std::size_t coalesce_joystick_moves(std::vector<sf::Event>& events) noexcept;
+
+/// \}
+
+}
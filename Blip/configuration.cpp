@@ -30,6 +30,17 @@ bool xml_converter<configuration>::deserialize(
     dx.data("AntialiasingLevel", t.antialiasing_level);
     dx.data("IsFullScreen", t.is_full_screen);
     dx.data("UseVerticalSync", t.use_vertical_sync);
+    dx.data("FrameRateLimit", t.frame_rate_limit);
+    dx.data("UseFixedTimeStep", t.use_fixed_time_step);
+    dx.data("TickRate", t.tick_rate);
+    dx.data("MaxTicksPerFrame", t.max_ticks_per_frame);
+    dx.data("TextureUploadBudget", t.texture_upload_budget);
+    dx.data("TextureRetentionBudget", t.texture_retention_budget);
+    dx.data("ImageRetentionBudget", t.image_retention_budget);
+    dx.data("SoundBufferRetentionBudget", t.sound_buffer_retention_budget);
+    dx.data("FontRetentionBudget", t.font_retention_budget);
+    dx.data("UseHotReload", t.use_hot_reload);
+    dx.data("HotReloadDelay", t.hot_reload_delay);
     return true;
 }
 
@@ -43,6 +54,17 @@ bool xml_converter<configuration>::serialize(
     sx.data("AntialiasingLevel", t.antialiasing_level);
     sx.data("IsFullScreen", t.is_full_screen);
     sx.data("UseVerticalSync", t.use_vertical_sync);
+    sx.data("FrameRateLimit", t.frame_rate_limit);
+    sx.data("UseFixedTimeStep", t.use_fixed_time_step);
+    sx.data("TickRate", t.tick_rate);
+    sx.data("MaxTicksPerFrame", t.max_ticks_per_frame);
+    sx.data("TextureUploadBudget", t.texture_upload_budget);
+    sx.data("TextureRetentionBudget", t.texture_retention_budget);
+    sx.data("ImageRetentionBudget", t.image_retention_budget);
+    sx.data("SoundBufferRetentionBudget", t.sound_buffer_retention_budget);
+    sx.data("FontRetentionBudget", t.font_retention_budget);
+    sx.data("UseHotReload", t.use_hot_reload);
+    sx.data("HotReloadDelay", t.hot_reload_delay);
     return true;
 }
 
@@ -23,6 +23,33 @@ struct configuration
     unsigned antialiasing_level{0}; //!< Antialiasing level of the renderer
     bool is_full_screen{true}; //!< Whether the render window is full screen
     bool use_vertical_sync{false}; //!< Whether the renderer uses vsync
+    unsigned frame_rate_limit{0}; //!< Maximum frame rate, or 0 if unlimited
+    bool use_fixed_time_step{false}; //!< Whether updates use a fixed step
+    unsigned tick_rate{120}; //!< Fixed update rate in ticks per second
+    unsigned max_ticks_per_frame{8}; //!< Maximum fixed updates per frame
+
+    /// \brief Time spent uploading textures per frame, in milliseconds
+    float texture_upload_budget{2.0f};
+
+    /// \brief Memory for recently used textures, in kibibytes
+    unsigned texture_retention_budget{65536};
+
+    /// \brief Memory for recently used images, in kibibytes
+    unsigned image_retention_budget{16384};
+
+    /// \brief Memory for recently used sound buffers, in kibibytes
+    unsigned sound_buffer_retention_budget{32768};
+
+    /// \brief Memory for recently used fonts, in kibibytes
+    unsigned font_retention_budget{4096};
+
+    /// \brief Whether changed resource and configuration files are
+    /// reloaded while running
+    bool use_hot_reload{false};
+
+    /// \brief Time a changed file must be left unchanged before it is
+    /// reloaded, in milliseconds
+    unsigned hot_reload_delay{100};
 
     /// \brief Initializes a new instance of the \ref configuration structure
     configuration();
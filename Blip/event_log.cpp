@@ -0,0 +1,376 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the binary event log implementation
+/// \ingroup application
+
+#include "blip/event_log.hpp"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+/// \brief Bytes identifying an event log
+constexpr std::array<char, 4> magic{{'B', 'E', 'V', 'L'}};
+
+/// \brief Version of the event log format
+constexpr std::uint32_t version = 1;
+
+/// \brief Key modifier flags stored with key events
+enum key_modifier : std::uint8_t
+{
+    alt_modifier = 1 << 0, //!< Alt key is pressed
+    control_modifier = 1 << 1, //!< Control key is pressed
+    shift_modifier = 1 << 2, //!< Shift key is pressed
+    system_modifier = 1 << 3, //!< System key is pressed
+};
+
+/// \brief Appends an unsigned integer in little-endian byte order
+/// \param buffer buffer to append to
+/// \param value value to append
+/// \param size number of bytes to append
+void put(std::vector<char>& buffer, std::uint64_t value, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        buffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+/// \brief Appends a signed integer in little-endian byte order
+/// \param buffer buffer to append to
+/// \param value value to append
+void put_int(std::vector<char>& buffer, int value)
+{
+    put(buffer, static_cast<std::uint32_t>(value), 4);
+}
+
+/// \brief Appends a floating-point value in little-endian byte order
+/// \param buffer buffer to append to
+/// \param value value to append
+void put_float(std::vector<char>& buffer, float value)
+{
+    static_assert(sizeof(float) == sizeof(std::uint32_t),
+        "float must be 32 bits");
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put(buffer, bits, 4);
+}
+
+/// \brief Reads an unsigned integer in little-endian byte order
+/// \param is stream to read from
+/// \param value value to read into
+/// \param size number of bytes to read
+/// \return whether the value was read
+bool get(std::istream& is, std::uint64_t& value, std::size_t size)
+{
+    std::array<unsigned char, 8> bytes;
+    is.read(reinterpret_cast<char*>(bytes.data()),
+        static_cast<std::streamsize>(size));
+    if (static_cast<std::size_t>(is.gcount()) != size) {
+        return false;
+    }
+    value = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        value |= static_cast<std::uint64_t>(bytes[i]) << (i * 8);
+    }
+    return true;
+}
+
+/// \brief Reads an unsigned integer in little-endian byte order
+/// \param is stream to read from
+/// \param size number of bytes to read
+/// \return value read
+///
+/// Throws \ref std::runtime_error if the stream ends.
+std::uint64_t get(std::istream& is, std::size_t size)
+{
+    std::uint64_t value;
+    if (!get(is, value, size)) {
+        throw std::runtime_error{"event log is truncated"};
+    }
+    return value;
+}
+
+/// \brief Reads a signed integer in little-endian byte order
+/// \param is stream to read from
+/// \return value read
+int get_int(std::istream& is)
+{
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(get(is, 4)));
+}
+
+/// \brief Reads a floating-point value in little-endian byte order
+/// \param is stream to read from
+/// \return value read
+float get_float(std::istream& is)
+{
+    auto bits = static_cast<std::uint32_t>(get(is, 4));
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/// \brief Appends the encoding of an event
+/// \param buffer buffer to append to
+/// \param event event to encode
+void encode(std::vector<char>& buffer, sf::Event const& event)
+{
+    put(buffer, event.type, 1);
+    switch (event.type) {
+        case sf::Event::Resized:
+            put(buffer, event.size.width, 4);
+            put(buffer, event.size.height, 4);
+            break;
+
+        case sf::Event::TextEntered:
+            put(buffer, event.text.unicode, 4);
+            break;
+
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            put_int(buffer, event.key.code);
+            put(buffer, (event.key.alt ? alt_modifier : 0)
+                | (event.key.control ? control_modifier : 0)
+                | (event.key.shift ? shift_modifier : 0)
+                | (event.key.system ? system_modifier : 0), 1);
+            break;
+
+        case sf::Event::MouseWheelMoved:
+            put_int(buffer, event.mouseWheel.delta);
+            put_int(buffer, event.mouseWheel.x);
+            put_int(buffer, event.mouseWheel.y);
+            break;
+
+        case sf::Event::MouseWheelScrolled:
+            put(buffer, event.mouseWheelScroll.wheel, 1);
+            put_float(buffer, event.mouseWheelScroll.delta);
+            put_int(buffer, event.mouseWheelScroll.x);
+            put_int(buffer, event.mouseWheelScroll.y);
+            break;
+
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            put(buffer, event.mouseButton.button, 1);
+            put_int(buffer, event.mouseButton.x);
+            put_int(buffer, event.mouseButton.y);
+            break;
+
+        case sf::Event::MouseMoved:
+            put_int(buffer, event.mouseMove.x);
+            put_int(buffer, event.mouseMove.y);
+            break;
+
+        case sf::Event::JoystickButtonPressed:
+        case sf::Event::JoystickButtonReleased:
+            put(buffer, event.joystickButton.joystickId, 1);
+            put(buffer, event.joystickButton.button, 1);
+            break;
+
+        case sf::Event::JoystickMoved:
+            put(buffer, event.joystickMove.joystickId, 1);
+            put(buffer, event.joystickMove.axis, 1);
+            put_float(buffer, event.joystickMove.position);
+            break;
+
+        case sf::Event::JoystickConnected:
+        case sf::Event::JoystickDisconnected:
+            put(buffer, event.joystickConnect.joystickId, 1);
+            break;
+
+        case sf::Event::TouchBegan:
+        case sf::Event::TouchMoved:
+        case sf::Event::TouchEnded:
+            put(buffer, event.touch.finger, 4);
+            put_int(buffer, event.touch.x);
+            put_int(buffer, event.touch.y);
+            break;
+
+        case sf::Event::SensorChanged:
+            put(buffer, event.sensor.type, 1);
+            put_float(buffer, event.sensor.x);
+            put_float(buffer, event.sensor.y);
+            put_float(buffer, event.sensor.z);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/// \brief Reads the encoding of an event
+/// \param is stream to read from
+/// \return decoded event
+sf::Event decode(std::istream& is)
+{
+    sf::Event event;
+    auto type = get(is, 1);
+    if (type >= sf::Event::Count) {
+        throw std::runtime_error{"event log has an invalid event type"};
+    }
+    event.type = static_cast<sf::Event::EventType>(type);
+    switch (event.type) {
+        case sf::Event::Resized:
+            event.size.width = static_cast<unsigned>(get(is, 4));
+            event.size.height = static_cast<unsigned>(get(is, 4));
+            break;
+
+        case sf::Event::TextEntered:
+            event.text.unicode = static_cast<sf::Uint32>(get(is, 4));
+            break;
+
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased: {
+            event.key.code = static_cast<sf::Keyboard::Key>(get_int(is));
+            auto modifiers = get(is, 1);
+            event.key.alt = (modifiers & alt_modifier) != 0;
+            event.key.control = (modifiers & control_modifier) != 0;
+            event.key.shift = (modifiers & shift_modifier) != 0;
+            event.key.system = (modifiers & system_modifier) != 0;
+            break;
+        }
+
+        case sf::Event::MouseWheelMoved:
+            event.mouseWheel.delta = get_int(is);
+            event.mouseWheel.x = get_int(is);
+            event.mouseWheel.y = get_int(is);
+            break;
+
+        case sf::Event::MouseWheelScrolled:
+            event.mouseWheelScroll.wheel =
+                static_cast<sf::Mouse::Wheel>(get(is, 1));
+            event.mouseWheelScroll.delta = get_float(is);
+            event.mouseWheelScroll.x = get_int(is);
+            event.mouseWheelScroll.y = get_int(is);
+            break;
+
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            event.mouseButton.button =
+                static_cast<sf::Mouse::Button>(get(is, 1));
+            event.mouseButton.x = get_int(is);
+            event.mouseButton.y = get_int(is);
+            break;
+
+        case sf::Event::MouseMoved:
+            event.mouseMove.x = get_int(is);
+            event.mouseMove.y = get_int(is);
+            break;
+
+        case sf::Event::JoystickButtonPressed:
+        case sf::Event::JoystickButtonReleased:
+            event.joystickButton.joystickId =
+                static_cast<unsigned>(get(is, 1));
+            event.joystickButton.button = static_cast<unsigned>(get(is, 1));
+            break;
+
+        case sf::Event::JoystickMoved:
+            event.joystickMove.joystickId =
+                static_cast<unsigned>(get(is, 1));
+            event.joystickMove.axis =
+                static_cast<sf::Joystick::Axis>(get(is, 1));
+            event.joystickMove.position = get_float(is);
+            break;
+
+        case sf::Event::JoystickConnected:
+        case sf::Event::JoystickDisconnected:
+            event.joystickConnect.joystickId =
+                static_cast<unsigned>(get(is, 1));
+            break;
+
+        case sf::Event::TouchBegan:
+        case sf::Event::TouchMoved:
+        case sf::Event::TouchEnded:
+            event.touch.finger = static_cast<unsigned>(get(is, 4));
+            event.touch.x = get_int(is);
+            event.touch.y = get_int(is);
+            break;
+
+        case sf::Event::SensorChanged:
+            event.sensor.type = static_cast<sf::Sensor::Type>(get(is, 1));
+            event.sensor.x = get_float(is);
+            event.sensor.y = get_float(is);
+            event.sensor.z = get_float(is);
+            break;
+
+        default:
+            break;
+    }
+    return event;
+}
+
+}
+
+namespace blip {
+
+event_log_writer::event_log_writer(std::string const& path)
+    : _file{path, std::ios::binary | std::ios::trunc}
+{
+    if (!_file) {
+        throw std::runtime_error{"unable to open event log"};
+    }
+    _buffer.assign(std::begin(magic), std::end(magic));
+    put(_buffer, version, 4);
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+}
+
+void event_log_writer::write(event_log_frame const& frame)
+{
+    // Encode the whole frame first so that it is written with a single call
+    _buffer.clear();
+    put(_buffer, frame.index, 4);
+    put(_buffer, frame.time, 8);
+    put_float(_buffer, frame.time_step);
+    put(_buffer, frame.events.size(), 4);
+    for (auto&& event : frame.events) {
+        encode(_buffer, event);
+    }
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+}
+
+void event_log_writer::flush()
+{
+    _file.flush();
+}
+
+event_log_reader::event_log_reader(std::string const& path)
+    : _file{path, std::ios::binary}
+{
+    if (!_file) {
+        throw std::runtime_error{"unable to open event log"};
+    }
+    std::array<char, magic.size()> bytes;
+    _file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    std::uint64_t file_version;
+    if (!_file || bytes != magic || !get(_file, file_version, 4)) {
+        throw std::runtime_error{"file is not an event log"};
+    }
+    if (file_version != version) {
+        throw std::runtime_error{"unsupported event log version"};
+    }
+}
+
+bool event_log_reader::read(event_log_frame& frame)
+{
+    std::uint64_t index;
+    if (!get(_file, index, 4)) {
+        if (_file.gcount() != 0) {
+            throw std::runtime_error{"event log is truncated"};
+        }
+        return false;
+    }
+    frame.index = static_cast<std::uint32_t>(index);
+    frame.time = get(_file, 8);
+    frame.time_step = get_float(_file);
+    auto count = get(_file, 4);
+    frame.events.clear();
+    for (; count > 0; --count) {
+        frame.events.emplace_back(decode(_file));
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,95 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the binary event log interface
+/// \ingroup application
+
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Events supplied during a single frame of a recording
+struct event_log_frame
+{
+    std::uint32_t index{0}; //!< Index of the frame
+    std::uint64_t time{0}; //!< Microseconds since the recording began
+    float time_step{0.0f}; //!< Time step of the frame in seconds
+    std::vector<sf::Event> events; //!< Events of the frame, in order
+};
+
+/// \brief Writes frames of events to a binary event log
+///
+/// The log begins with a short header identifying the format, followed by
+/// one record per frame. Each event is stored as its type followed by only
+/// the fields that the type uses, in little-endian byte order, so logs are
+/// compact and portable between platforms.
+class event_log_writer
+{
+public:
+    /// \brief Initializes a new instance of the \ref event_log_writer class
+    /// that writes to the given file
+    /// \param path path to the log file, which is replaced
+    ///
+    /// Throws \ref std::runtime_error if the file cannot be opened.
+    explicit event_log_writer(std::string const& path);
+
+    /// \brief Deleted copy constructor
+    event_log_writer(event_log_writer const&) = delete;
+
+    /// \brief Deleted copy assignment operator
+    event_log_writer& operator=(event_log_writer const&) = delete;
+
+    /// \brief Writes a frame to the log
+    /// \param frame frame to write
+    void write(event_log_frame const& frame);
+
+    /// \brief Flushes written frames to the file
+    void flush();
+
+private:
+    std::ofstream _file; //!< Log file
+    std::vector<char> _buffer; //!< Encoding of the frame being written
+};
+
+/// \brief Reads frames of events from a binary event log
+class event_log_reader
+{
+public:
+    /// \brief Initializes a new instance of the \ref event_log_reader class
+    /// that reads from the given file
+    /// \param path path to the log file
+    ///
+    /// Throws \ref std::runtime_error if the file cannot be opened or is not
+    /// an event log.
+    explicit event_log_reader(std::string const& path);
+
+    /// \brief Deleted copy constructor
+    event_log_reader(event_log_reader const&) = delete;
+
+    /// \brief Deleted copy assignment operator
+    event_log_reader& operator=(event_log_reader const&) = delete;
+
+    /// \brief Reads the next frame from the log
+    /// \param frame frame to read into
+    /// \return whether a frame was read, or false at the end of the log
+    ///
+    /// Throws \ref std::runtime_error if the log is corrupt or truncated.
+    bool read(event_log_frame& frame);
+
+private:
+    std::ifstream _file; //!< Log file
+};
+
+/// \}
+
+}
@@ -0,0 +1,28 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::event_source class implementation
+/// \ingroup application
+
+#include "blip/event_source.hpp"
+
+namespace blip {
+
+event_source::~event_source() = default;
+
+float event_source::time_step(float measured)
+{
+    return measured;
+}
+
+void event_source::next_frame()
+{
+}
+
+bool event_source::is_finished() const
+{
+    return false;
+}
+
+}
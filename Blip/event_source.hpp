@@ -0,0 +1,58 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::event_source class interface
+/// \ingroup application
+
+#pragma once
+
+namespace sf {
+
+// Forward declarations
+class Event;
+
+}
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Interface implemented by types that supply events to the
+/// \ref application
+class event_source
+{
+public:
+    /// \brief Destructs the \ref event_source instance
+    virtual ~event_source();
+
+    /// \brief Gets the time step of the next frame
+    /// \param measured time step measured by the \ref application
+    /// \return time step to use for the frame
+    ///
+    /// Called once at the beginning of each frame, before \ref next_frame.
+    /// Sources replaying recorded input return the recorded time step so
+    /// that replays are deterministic.
+    virtual float time_step(float measured);
+
+    /// \brief Prepares the events of the next frame
+    ///
+    /// Called once at the beginning of each frame, before polling.
+    virtual void next_frame();
+
+    /// \brief Gets a value indicating whether the source has no more events
+    /// \return whether the source is exhausted
+    ///
+    /// The \ref application exits once its event source is exhausted.
+    virtual bool is_finished() const;
+
+    /// \brief Pops the next pending event of the current frame
+    /// \param event event to pop into
+    /// \return whether an event was popped
+    virtual bool poll(sf::Event& event) = 0;
+};
+
+/// \}
+
+}
@@ -0,0 +1,92 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::file_watcher class implementation
+/// \ingroup resource
+
+#include "blip/file_watcher.hpp"
+#include "blip/trace.hpp"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace blip {
+
+file_watcher::file_watcher(
+    callback_type callback,
+    std::chrono::milliseconds delay)
+    : _callback{std::move(callback)}
+    , _delay{delay}
+{
+}
+
+file_watcher::~file_watcher()
+{
+    // The platform threads record changes, so they are stopped first
+    _platform.reset();
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _should_stop = true;
+    }
+    _wake.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void file_watcher::changed(std::string const& path)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _changes[path] = clock_type::now();
+        if (!_thread.joinable()) {
+            _thread = std::thread{&file_watcher::report, this};
+        }
+    }
+    _wake.notify_one();
+}
+
+void file_watcher::report()
+{
+    trace_thread_name("File watcher");
+    std::vector<std::string> paths;
+    std::unique_lock<std::mutex> lock{_mutex};
+    while (!_should_stop) {
+        // Changes are reported once the file has been quiet for the delay;
+        // the thread sleeps until the earliest of them is due
+        auto now = clock_type::now();
+        auto next = clock_type::time_point::max();
+        for (auto iter = std::begin(_changes); iter != std::end(_changes);) {
+            auto due = iter->second + _delay;
+            if (due <= now) {
+                paths.emplace_back(iter->first);
+                iter = _changes.erase(iter);
+            }
+            else {
+                next = std::min(next, due);
+                ++iter;
+            }
+        }
+
+        if (!paths.empty()) {
+            lock.unlock();
+            for (auto&& path : paths) {
+                _callback(path);
+            }
+            paths.clear();
+            lock.lock();
+            continue;
+        }
+
+        if (next == clock_type::time_point::max()) {
+            _wake.wait(lock);
+        }
+        else {
+            _wake.wait_until(lock, next);
+        }
+    }
+}
+
+}
@@ -0,0 +1,106 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::file_watcher class interface
+/// \ingroup resource
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Watches directories for files that are written
+///
+/// Changes are reported through a callback on a thread of the watcher, once
+/// a file has been left unchanged for the watcher's delay, so that a file
+/// written in several steps, or saved by an editor through a temporary
+/// file, is reported only once and only when complete.
+///
+/// Changes are detected with inotify on Linux and ReadDirectoryChangesW on
+/// Windows. On Mac, the watched files are polled for changes to their
+/// modification times.
+class file_watcher
+{
+public:
+    /// \brief Type of clock used to delay changes
+    using clock_type = std::chrono::steady_clock;
+
+    /// \brief Type of function called with the path of a changed file
+    using callback_type = std::function<void(std::string const& path)>;
+
+    /// \brief Initializes a new instance of the \ref file_watcher class
+    /// \param callback function called with the full path of each changed
+    /// file, on a thread of the watcher
+    /// \param delay time a file must be left unchanged before it is
+    /// reported
+    explicit file_watcher(
+        callback_type callback,
+        std::chrono::milliseconds delay = std::chrono::milliseconds{100});
+
+    /// \brief Deleted copy constructor
+    file_watcher(file_watcher const&) = delete;
+
+    /// \brief Destructs the \ref file_watcher instance, stopping its threads
+    ///
+    /// Changes that have not yet been reported are discarded.
+    ~file_watcher();
+
+    /// \brief Deleted copy assignment operator
+    file_watcher& operator=(file_watcher const&) = delete;
+
+    /// \brief Gets the time a file must be left unchanged before it is
+    /// reported
+    /// \return delay
+    std::chrono::milliseconds delay() const noexcept { return _delay; }
+
+    /// \brief Starts watching a directory and its subdirectories
+    /// \param path path to the directory
+    /// \return whether the directory is watched
+    bool watch(std::string const& path);
+
+private:
+    /// \brief Platform-specific state of the watcher
+    struct platform_type;
+
+    /// \brief Records a change to a file, delaying its report
+    /// \param path full path of the changed file
+    ///
+    /// Called by the platform-specific threads.
+    void changed(std::string const& path);
+
+    /// \brief Reports changes once their delay has passed, until the watcher
+    /// is stopped
+    void report();
+
+    callback_type _callback; //!< Function called for changed files
+    std::chrono::milliseconds _delay; //!< Delay before changes are reported
+
+    /// \brief Platform-specific state, created by the first \ref watch,
+    /// which stops the platform-specific threads when destroyed
+    std::shared_ptr<platform_type> _platform;
+
+    std::mutex _mutex; //!< Mutex guarding the changes and the stop flag
+    std::condition_variable _wake; //!< Wakes the thread for a change
+
+    /// \brief Time of the latest change to each file not yet reported
+    std::map<std::string, clock_type::time_point> _changes;
+
+    bool _should_stop{false}; //!< Whether the thread should stop
+    std::thread _thread; //!< Thread reporting changes
+};
+
+/// \}
+
+}
@@ -0,0 +1,128 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::fixed_vector class template interface
+/// \ingroup utility
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace blip {
+
+/// \addtogroup utility
+/// \{
+
+/// \brief Sequence container with a fixed capacity and inline storage
+/// \tparam T type of element, which must be default constructible
+/// \tparam N capacity of the container
+///
+/// Never allocates, which makes it suitable for per-frame scratch buffers.
+/// Elements beyond the size are kept default constructed or hold stale
+/// values, so \p T should be cheap to assign.
+template <typename T, std::size_t N>
+class fixed_vector
+{
+public:
+    /// \brief Type of element
+    using value_type = T;
+
+    /// \brief Type of size
+    using size_type = std::size_t;
+
+    /// \brief Type of iterator
+    using iterator = T*;
+
+    /// \brief Type of constant iterator
+    using const_iterator = T const*;
+
+    /// \brief Gets the number of elements
+    /// \return number of elements
+    size_type size() const noexcept { return _size; }
+
+    /// \brief Gets the maximum number of elements
+    /// \return capacity
+    static constexpr size_type capacity() noexcept { return N; }
+
+    /// \brief Gets a value indicating whether there are no elements
+    /// \return whether the container is empty
+    bool empty() const noexcept { return _size == 0; }
+
+    /// \brief Gets a value indicating whether the container is at capacity
+    /// \return whether the container is full
+    bool full() const noexcept { return _size == N; }
+
+    /// \brief Gets a pointer to the storage
+    /// \return pointer to the first element
+    T* data() noexcept { return _elements.data(); }
+
+    /// \brief Gets a pointer to the storage
+    /// \return pointer to the first element
+    T const* data() const noexcept { return _elements.data(); }
+
+    /// \brief Obtains an iterator to the first element
+    /// \return iterator to the first element
+    iterator begin() noexcept { return data(); }
+
+    /// \brief Obtains an iterator to the first element
+    /// \return iterator to the first element
+    const_iterator begin() const noexcept { return data(); }
+
+    /// \brief Obtains an iterator past the last element
+    /// \return iterator past the last element
+    iterator end() noexcept { return data() + _size; }
+
+    /// \brief Obtains an iterator past the last element
+    /// \return iterator past the last element
+    const_iterator end() const noexcept { return data() + _size; }
+
+    /// \brief Gets an element by index
+    /// \param i index of the element, less than \ref size
+    /// \return reference to the element
+    T& operator[](size_type i) noexcept { return _elements[i]; }
+
+    /// \brief Gets an element by index
+    /// \param i index of the element, less than \ref size
+    /// \return reference to the element
+    T const& operator[](size_type i) const noexcept { return _elements[i]; }
+
+    /// \brief Removes every element
+    void clear() noexcept { _size = 0; }
+
+    /// \brief Changes the number of elements
+    /// \param size new number of elements, at most \ref capacity
+    ///
+    /// Used after writing elements directly into \ref data. Throws
+    /// \ref std::length_error if \p size exceeds the capacity.
+    void resize(size_type size)
+    {
+        if (size > N) {
+            throw std::length_error{"fixed_vector capacity exceeded"};
+        }
+        _size = size;
+    }
+
+    /// \brief Appends an element if there is room
+    /// \param value element to append
+    /// \return whether the element was appended
+    bool push_back(T value)
+    {
+        if (full()) {
+            return false;
+        }
+        _elements[_size++] = std::move(value);
+        return true;
+    }
+
+private:
+    std::array<T, N> _elements; //!< Element storage
+    size_type _size{0}; //!< Number of elements
+};
+
+/// \}
+
+}
@@ -0,0 +1,64 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::frame_pacer class implementation
+/// \ingroup application
+
+#include "blip/frame_pacer.hpp"
+#include <SFML/System/Sleep.hpp>
+
+namespace {
+
+/// \brief Smallest margin left for spinning at the end of a frame
+sf::Time const min_spin_margin = sf::microseconds(100);
+
+/// \brief Weight given to each new sample in the jitter average
+constexpr sf::Int64 jitter_smoothing = 8;
+
+}
+
+namespace blip {
+
+void frame_pacer::frame_rate(unsigned rate)
+{
+    _frame_rate = rate;
+    _frame_time = rate > 0 ? sf::seconds(1.0f / rate) : sf::Time::Zero;
+    _deadline = _clock.getElapsedTime();
+}
+
+void frame_pacer::wait()
+{
+    if (_frame_rate == 0) {
+        return;
+    }
+
+    _deadline += _frame_time;
+    auto now = _clock.getElapsedTime();
+    if (now - _deadline > _frame_time) {
+        _deadline = now;
+        return;
+    }
+
+    // Sleep through most of the frame, leaving enough time to absorb the
+    // usual oversleep of the system timer
+    auto margin = _jitter + _jitter + min_spin_margin;
+    if (_deadline - now > margin) {
+        auto request = _deadline - now - margin;
+        sf::sleep(request);
+        auto slept = _clock.getElapsedTime() - now;
+        auto overrun = (slept - request).asMicroseconds();
+        if (overrun < 0) {
+            overrun = 0;
+        }
+        auto average = _jitter.asMicroseconds();
+        _jitter = sf::microseconds(
+            average + (overrun - average) / jitter_smoothing);
+    }
+
+    // Spin for the remainder
+    while (_clock.getElapsedTime() < _deadline) {
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::frame_pacer class interface
+/// \ingroup application
+
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Limits the frame rate without busy-waiting for the whole frame
+///
+/// Each wait sleeps for most of the remaining frame time and spins only for
+/// a short margin at the end. The margin follows the measured oversleep of
+/// the system timer, so that the deadline is met closely on platforms with
+/// coarse sleep resolution while keeping the spin as short as possible.
+class frame_pacer
+{
+public:
+    /// \brief Gets the target frame rate
+    /// \return target frame rate in frames per second, or 0 if unlimited
+    unsigned frame_rate() const noexcept { return _frame_rate; }
+
+    /// \brief Sets the target frame rate
+    /// \param rate target frame rate in frames per second, or 0 to disable
+    /// the limit
+    void frame_rate(unsigned rate);
+
+    /// \brief Gets the average amount by which sleeps overrun their request
+    /// \return measured sleep jitter
+    sf::Time jitter() const noexcept { return _jitter; }
+
+    /// \brief Waits until the current frame has taken the target frame time
+    ///
+    /// Does nothing if the frame rate is unlimited. If the frame has already
+    /// overrun its deadline by more than a whole frame, the schedule is
+    /// reset rather than trying to catch up with a burst of short frames.
+    void wait();
+
+private:
+    unsigned _frame_rate{0}; //!< Target frame rate
+    sf::Time _frame_time; //!< Target frame time
+    sf::Time _deadline; //!< Deadline of the current frame
+    sf::Time _jitter{sf::milliseconds(1)}; //!< Average sleep overrun
+    sf::Clock _clock; //!< Clock for measuring deadlines
+};
+
+/// \}
+
+}
@@ -0,0 +1,273 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::frame_profiler class implementation
+/// \ingroup profile
+
+#include "blip/frame_profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+/// \brief Mapping between \ref blip::profile_phase values and their names
+constexpr std::pair<blip::profile_phase, char const*>
+profile_phase_names[] =
+{
+    {blip::profile_phase::work, "Work"},
+    {blip::profile_phase::notify, "Notify"},
+    {blip::profile_phase::update, "Update"},
+    {blip::profile_phase::draw, "Draw"},
+    {blip::profile_phase::wait, "Wait"},
+};
+
+/// \brief Timing marking a frame in which a state was not timed
+constexpr blip::frame_profiler::duration absent{-1};
+
+/// \brief Writes a row of statistics in milliseconds
+/// \param os stream to write to
+/// \param name name of the row
+/// \param stats statistics to write
+void write_row(
+    std::ostream& os,
+    std::string const& name,
+    blip::profile_statistics const& stats)
+{
+    auto ms = [](blip::frame_profiler::duration d)
+    { return std::chrono::duration<double, std::milli>{d}.count(); };
+    os << std::left << std::setw(32) << name << std::right
+        << std::setw(8) << stats.count
+        << std::setw(10) << ms(stats.min)
+        << std::setw(10) << ms(stats.average)
+        << std::setw(10) << ms(stats.p99)
+        << std::setw(10) << ms(stats.max) << '\n';
+}
+
+}
+
+namespace blip {
+
+frame_profiler::frame_profiler(std::size_t capacity)
+    : _frames(capacity)
+{
+    if (capacity == 0) {
+        throw std::invalid_argument{"profiler capacity must be nonzero"};
+    }
+}
+
+void frame_profiler::clear()
+{
+    _is_in_frame = false;
+    _next = 0;
+    _size = 0;
+    _states.clear();
+}
+
+void frame_profiler::begin_frame()
+{
+#if BLIP_ENABLE_PROFILER
+    if (!is_enabled()) {
+        return;
+    }
+    _current = frame{};
+    _frame_start = clock_type::now();
+    _is_in_frame = true;
+#endif
+}
+
+void frame_profiler::end_frame()
+{
+#if BLIP_ENABLE_PROFILER
+    if (!_is_in_frame) {
+        return;
+    }
+    _is_in_frame = false;
+    _current.total = std::chrono::duration_cast<duration>(
+        clock_type::now() - _frame_start);
+    _frames[_next] = _current;
+
+    for (auto&& pair : _states) {
+        auto& s = pair.second;
+        if (s.is_current) {
+            s.frames[_next] = s.current;
+            s.current.fill(absent);
+            s.is_current = false;
+        }
+        else {
+            s.frames[_next].fill(absent);
+        }
+    }
+
+    _next = (_next + 1) % _frames.size();
+    _size = std::min(_size + 1, _frames.size());
+#endif
+}
+
+void frame_profiler::record(profile_phase phase, duration time)
+{
+    if (_is_in_frame) {
+        _current.phases[static_cast<std::size_t>(phase)] += time;
+    }
+}
+
+void frame_profiler::record(
+    std::type_index state,
+    profile_phase phase,
+    duration time)
+{
+    if (!_is_in_frame) {
+        return;
+    }
+    auto iter = _states.find(state);
+    if (iter == std::end(_states)) {
+        state_frames s;
+        s.frames.resize(_frames.size());
+        for (auto&& f : s.frames) {
+            f.fill(absent);
+        }
+        s.current.fill(absent);
+        iter = _states.emplace(state, std::move(s)).first;
+    }
+
+    auto& current = iter->second.current[static_cast<std::size_t>(phase)];
+    current = current == absent ? time : current + time;
+    iter->second.is_current = true;
+}
+
+template <typename Select>
+profile_statistics frame_profiler::summarize(Select select) const
+{
+    std::vector<duration> times;
+    times.reserve(_size);
+
+    // The oldest recorded frame is at the next index once the buffer wraps
+    auto first = _size < _frames.size() ? 0 : _next;
+    for (std::size_t n = 0; n < _size; ++n) {
+        duration d;
+        if (select((first + n) % _frames.size(), d)) {
+            times.emplace_back(d);
+        }
+    }
+
+    profile_statistics stats;
+    stats.count = times.size();
+    if (times.empty()) {
+        return stats;
+    }
+
+    std::sort(std::begin(times), std::end(times));
+    duration sum{0};
+    for (auto&& t : times) {
+        sum += t;
+    }
+    stats.min = times.front();
+    stats.max = times.back();
+    stats.average = sum / static_cast<duration::rep>(times.size());
+    stats.p99 = times[(times.size() * 99 + 99) / 100 - 1];
+    return stats;
+}
+
+profile_statistics frame_profiler::statistics() const
+{
+    return summarize([this](std::size_t i, duration& d)
+    {
+        d = _frames[i].total;
+        return true;
+    });
+}
+
+profile_statistics frame_profiler::statistics(profile_phase phase) const
+{
+    auto p = static_cast<std::size_t>(phase);
+    return summarize([this, p](std::size_t i, duration& d)
+    {
+        d = _frames[i].phases[p];
+        return true;
+    });
+}
+
+profile_statistics frame_profiler::statistics(
+    std::type_index state,
+    profile_phase phase) const
+{
+    auto iter = _states.find(state);
+    if (iter == std::end(_states)) {
+        return {};
+    }
+    auto& frames = iter->second.frames;
+    auto p = static_cast<std::size_t>(phase);
+    return summarize([&frames, p](std::size_t i, duration& d)
+    {
+        d = frames[i][p];
+        return d != absent;
+    });
+}
+
+std::vector<std::type_index> frame_profiler::states() const
+{
+    std::vector<std::type_index> types;
+    for (auto&& pair : _states) {
+        types.emplace_back(pair.first);
+    }
+    return types;
+}
+
+void frame_profiler::dump(std::ostream& os) const
+{
+    os << std::fixed << std::setprecision(3)
+        << "Frames: " << _size << " of " << _frames.size() << "\n\n"
+        << std::left << std::setw(32) << "Timing (ms)" << std::right
+        << std::setw(8) << "Count"
+        << std::setw(10) << "Min"
+        << std::setw(10) << "Avg"
+        << std::setw(10) << "P99"
+        << std::setw(10) << "Max" << '\n';
+
+    write_row(os, "Frame", statistics());
+    for (auto&& pair : profile_phase_names) {
+        write_row(os, pair.second, statistics(pair.first));
+    }
+
+    for (auto&& state : states()) {
+        for (auto&& pair : profile_phase_names) {
+            auto stats = statistics(state, pair.first);
+            if (stats.count > 0) {
+                write_row(os, std::string{state.name()} + ' ' + pair.second,
+                    stats);
+            }
+        }
+    }
+}
+
+bool frame_profiler::dump(std::string const& path) const
+{
+    std::ofstream os{path};
+    if (!os) {
+        return false;
+    }
+    dump(os);
+    return !os.fail();
+}
+
+std::ostream& operator<<(std::ostream& os, profile_phase rhs)
+{
+    std::ostream::sentry sentry{os};
+    if (!sentry) {
+        return os;
+    }
+
+    for (auto&& pair : profile_phase_names) {
+        if (rhs == pair.first) {
+            return os << pair.second;
+        }
+    }
+
+    throw std::logic_error{"unmapped profile_phase"};
+}
+
+}
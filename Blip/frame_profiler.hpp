@@ -0,0 +1,293 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::frame_profiler class interface
+/// \ingroup profile
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+/// \brief Whether the frame profiler is compiled in
+///
+/// Define as 0 to compile out all profiler instrumentation; the profiler
+/// interface remains available but records nothing.
+#ifndef BLIP_ENABLE_PROFILER
+#define BLIP_ENABLE_PROFILER 1
+#endif
+
+namespace blip {
+
+/// \addtogroup profile
+/// \{
+
+/// \brief Phases of a frame timed by the \ref frame_profiler
+enum class profile_phase
+{
+    work, //!< Applying pending state manager jobs
+    notify, //!< Polling events and notifying states
+    update, //!< Updating states
+    draw, //!< Drawing states and presenting the frame
+    wait, //!< Waiting for the frame rate limiter
+};
+
+/// \brief Number of values in \ref profile_phase
+constexpr std::size_t profile_phase_count = 5;
+
+/// \brief Summary of a series of timings
+struct profile_statistics
+{
+    /// \brief Type of timing duration
+    using duration = std::chrono::nanoseconds;
+
+    std::size_t count{0}; //!< Number of timings
+    duration min{0}; //!< Shortest timing
+    duration average{0}; //!< Mean timing
+    duration p99{0}; //!< 99th percentile timing
+    duration max{0}; //!< Longest timing
+};
+
+/// \brief Records per-phase and per-state timings for recent frames
+///
+/// Timings are kept in a ring buffer holding the last \ref capacity frames,
+/// so the profiler has a fixed memory footprint and can remain enabled in
+/// production builds.
+class frame_profiler
+{
+public:
+    /// \brief Type of clock used for timing
+    using clock_type = std::chrono::steady_clock;
+
+    /// \brief Type of timing duration
+    using duration = profile_statistics::duration;
+
+    /// \brief Default number of frames kept by the profiler
+    static constexpr std::size_t default_capacity = 300;
+
+    /// \brief Initializes a new instance of the \ref frame_profiler class
+    /// with the given capacity
+    /// \param capacity number of frames to keep
+    explicit frame_profiler(std::size_t capacity = default_capacity);
+
+    /// \brief Gets a value indicating whether the profiler is recording
+    /// \return whether the profiler is recording
+    bool is_enabled() const noexcept
+    {
+        return BLIP_ENABLE_PROFILER && _is_enabled;
+    }
+
+    /// \brief Enables recording
+    void enable() noexcept { _is_enabled = true; }
+
+    /// \brief Disables recording
+    void disable() noexcept { _is_enabled = false; }
+
+    /// \brief Gets the number of frames the profiler keeps
+    /// \return frame capacity
+    std::size_t capacity() const noexcept { return _frames.size(); }
+
+    /// \brief Gets the number of frames currently recorded
+    /// \return number of recorded frames
+    std::size_t size() const noexcept { return _size; }
+
+    /// \brief Discards all recorded frames
+    void clear();
+
+    /// \brief Marks the beginning of a frame
+    void begin_frame();
+
+    /// \brief Marks the end of a frame, committing its timings
+    void end_frame();
+
+    /// \brief Adds a timing to a phase of the current frame
+    /// \param phase phase of the frame
+    /// \param time time spent in the phase
+    void record(profile_phase phase, duration time);
+
+    /// \brief Adds a timing to a state in a phase of the current frame
+    /// \param state type of the state
+    /// \param phase phase of the frame
+    /// \param time time spent by the state in the phase
+    void record(std::type_index state, profile_phase phase, duration time);
+
+    /// \brief Summarizes the recorded whole-frame timings
+    /// \return statistics for whole frames
+    profile_statistics statistics() const;
+
+    /// \brief Summarizes the recorded timings of a phase
+    /// \param phase phase of the frame
+    /// \return statistics for \p phase
+    profile_statistics statistics(profile_phase phase) const;
+
+    /// \brief Summarizes the recorded timings of a state in a phase
+    /// \param state type of the state
+    /// \param phase phase of the frame
+    /// \return statistics for \p state in \p phase
+    profile_statistics statistics(std::type_index state, profile_phase phase)
+        const;
+
+    /// \brief Gets the types of the states with recorded timings
+    /// \return list of state types
+    std::vector<std::type_index> states() const;
+
+    /// \brief Writes a report of the recorded timings to a stream
+    /// \param os stream to write to
+    void dump(std::ostream& os) const;
+
+    /// \brief Writes a report of the recorded timings to a file
+    /// \param path path to the file
+    /// \return whether the report was written
+    bool dump(std::string const& path) const;
+
+private:
+    /// \brief Timings of a single frame
+    struct frame
+    {
+        duration total{0}; //!< Whole-frame timing
+        std::array<duration, profile_phase_count> phases{}; //!< Timings
+    };
+
+    /// \brief Timings of a single state across the recorded frames
+    struct state_frames
+    {
+        /// \brief Timings of each recorded frame by phase
+        std::vector<std::array<duration, profile_phase_count>> frames;
+
+        /// \brief Timings of the current frame by phase
+        std::array<duration, profile_phase_count> current;
+
+        /// \brief Whether the state has timings in the current frame
+        bool is_current{false};
+    };
+
+    bool _is_enabled{true}; //!< Whether the profiler is recording
+    bool _is_in_frame{false}; //!< Whether a frame has begun
+    clock_type::time_point _frame_start; //!< Start time of the frame
+    frame _current; //!< Timings of the current frame
+    std::vector<frame> _frames; //!< Ring buffer of recorded frames
+    std::size_t _next{0}; //!< Index of the next frame to record
+    std::size_t _size{0}; //!< Number of recorded frames
+
+    /// \brief Timings recorded per state
+    std::map<std::type_index, state_frames> _states;
+
+    /// \brief Summarizes timings of the recorded frames
+    /// \tparam Select type of function selecting a timing from a frame index
+    /// \param select function returning the timing of a ring buffer index
+    /// and whether there was one
+    /// \return statistics for the selected timings
+    template <typename Select>
+    profile_statistics summarize(Select select) const;
+};
+
+/// \brief Times a scope and records it with a \ref frame_profiler
+///
+/// When \ref BLIP_ENABLE_PROFILER is 0, this type is empty and does nothing.
+class profile_scope
+{
+public:
+    /// \brief Initializes a new instance of the \ref profile_scope class
+    /// timing a phase
+    /// \param profiler profiler to record with, or null to record nothing
+    /// \param phase phase being timed
+    profile_scope(frame_profiler* profiler, profile_phase phase) noexcept
+#if BLIP_ENABLE_PROFILER
+        : _profiler{profiler}
+        , _phase{phase}
+    {
+        start();
+    }
+#else
+    {
+        static_cast<void>(profiler);
+        static_cast<void>(phase);
+    }
+#endif
+
+    /// \brief Initializes a new instance of the \ref profile_scope class
+    /// timing a state within a phase
+    /// \param profiler profiler to record with, or null to record nothing
+    /// \param state type of the state being timed
+    /// \param phase phase being timed
+    profile_scope(
+        frame_profiler* profiler,
+        std::type_index state,
+        profile_phase phase) noexcept
+#if BLIP_ENABLE_PROFILER
+        : _profiler{profiler}
+        , _phase{phase}
+        , _state{state}
+        , _has_state{true}
+    {
+        start();
+    }
+#else
+    {
+        static_cast<void>(profiler);
+        static_cast<void>(state);
+        static_cast<void>(phase);
+    }
+#endif
+
+    /// \brief Deleted copy constructor
+    profile_scope(profile_scope const&) = delete;
+
+    /// \brief Records the time spent in the scope
+    ~profile_scope()
+    {
+#if BLIP_ENABLE_PROFILER
+        if (_profiler == nullptr) {
+            return;
+        }
+        auto time = std::chrono::duration_cast<frame_profiler::duration>(
+            frame_profiler::clock_type::now() - _start);
+        if (_has_state) {
+            _profiler->record(_state, _phase, time);
+        }
+        else {
+            _profiler->record(_phase, time);
+        }
+#endif
+    }
+
+    /// \brief Deleted copy assignment operator
+    profile_scope& operator=(profile_scope const&) = delete;
+
+#if BLIP_ENABLE_PROFILER
+private:
+    frame_profiler* _profiler; //!< Profiler to record with
+    profile_phase _phase; //!< Phase being timed
+    std::type_index _state{typeid(void)}; //!< State being timed
+    bool _has_state{false}; //!< Whether a state is being timed
+    frame_profiler::clock_type::time_point _start; //!< Start of the scope
+
+    /// \brief Starts timing if the profiler is recording
+    void start() noexcept
+    {
+        if (_profiler != nullptr && !_profiler->is_enabled()) {
+            _profiler = nullptr;
+        }
+        if (_profiler != nullptr) {
+            _start = frame_profiler::clock_type::now();
+        }
+    }
+#endif
+};
+
+/// \brief Ouputs a \ref profile_phase to a \ref std::ostream
+/// \param os stream to output to
+/// \param rhs value to output
+/// \return \p os
+std::ostream& operator<<(std::ostream& os, profile_phase rhs);
+
+/// \}
+
+}
@@ -9,6 +9,7 @@
 
 #include "blip/input_signal.hpp"
 #include "blip/xml_converter.hpp"
+#include <cstddef>
 #include <string>
 
 namespace blip {
@@ -24,6 +25,10 @@ struct input_action
 
     /// \brief Signal required by the action
     input_signal signal;
+
+    /// \brief Dense identifier of the action among every action of its
+    /// specification, assigned by \ref input_specification::reindex
+    std::size_t id{0};
 };
 
 /// \}
@@ -9,7 +9,6 @@
 #include "blip/input_action_context.hpp"
 #include "blip/xml_deserializer.hpp"
 #include "blip/xml_serializer.hpp"
-#include <algorithm>
 #include <iterator>
 #include <stdexcept>
 #include <utility>
@@ -46,25 +45,39 @@ bool input_action_context::erase(std::string const& n)
         return false;
     }
     actions.erase(iter);
+    reindex();
     return true;
 }
 
+void input_action_context::reindex() const
+{
+    _index.clear();
+    for (std::size_t i = 0; i < actions.size(); ++i) {
+        _index.emplace(actions[i].name, i);
+    }
+    _indexed_count = actions.size();
+}
+
 auto input_action_context::find(std::string const& n) const
     -> decltype(actions)::const_iterator
 {
-    auto first = std::begin(actions);
-    auto last = std::end(actions);
-    auto pred = [&n](auto& i) { return i.name == n; };
-    return std::find_if(first, last, pred);
+    if (_indexed_count != actions.size()) {
+        reindex();
+    }
+    auto iter = _index.find(n);
+    if (iter == std::end(_index) || iter->second >= actions.size()) {
+        return std::end(actions);
+    }
+    auto pos = std::begin(actions)
+        + static_cast<std::ptrdiff_t>(iter->second);
+    return pos->name == n ? pos : std::end(actions);
 }
 
 auto input_action_context::find(std::string const& n)
     -> decltype(actions)::iterator
 {
-    auto first = std::begin(actions);
-    auto last = std::end(actions);
-    auto pred = [&n](auto& i) { return i.name == n; };
-    return std::find_if(first, last, pred);
+    auto iter = static_cast<input_action_context const&>(*this).find(n);
+    return std::begin(actions) + (iter - std::cbegin(actions));
 }
 
 bool xml_converter<input_action_context>::deserialize(
@@ -81,6 +94,7 @@ bool xml_converter<input_action_context>::deserialize(
         }
         t.actions.emplace_back(std::move(action));
     }
+    t.reindex();
     return true;
 }
 
@@ -9,7 +9,9 @@
 
 #include "blip/input_action.hpp"
 #include "blip/xml_converter.hpp"
+#include <cstddef>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace blip {
@@ -18,6 +20,10 @@ namespace blip {
 /// \{
 
 /// \brief Game-defined context of input actions
+///
+/// Actions are found by name through a hashed index. The index is rebuilt
+/// automatically when actions are added or removed, but \ref reindex must
+/// be called after actions are renamed or reordered in place.
 struct input_action_context
 {
     /// \brief Name of the action context
@@ -26,6 +32,13 @@ struct input_action_context
     /// \brief List of member actions
     std::vector<input_action> actions;
 
+    /// \brief Index of the context within its specification, assigned by
+    /// \ref input_specification::reindex
+    std::size_t id{0};
+
+    /// \brief Rebuilds the index of actions by name
+    void reindex() const;
+
     /// \brief Gets an action from the context by name
     /// \param name name of the action
     /// \return reference to an action with the given name
@@ -58,6 +71,13 @@ struct input_action_context
     /// \return iterator for the action
     auto find(std::string const& name)
         -> decltype(actions)::iterator;
+
+private:
+    /// \brief Positions of the actions by name
+    mutable std::unordered_map<std::string, std::size_t> _index;
+
+    /// \brief Number of actions when the index was built
+    mutable std::size_t _indexed_count{0};
 };
 
 /// \}
@@ -9,6 +9,8 @@
 #include "blip/input_event.hpp"
 #include "blip/xml_deserializer.hpp"
 #include "blip/xml_serializer.hpp"
+#include <algorithm>
+#include <cmath>
 #include <istream>
 #include <ostream>
 #include <stdexcept>
@@ -30,6 +32,15 @@ input_analog_activation_condition_names[] =
     {blip::input_analog_activation_condition::greater_equal, "GreaterEqual"},
 };
 
+/// \brief Mapping between \ref blip::input_dead_zone_shape values and their
+/// names
+constexpr std::pair<blip::input_dead_zone_shape, char const*>
+input_dead_zone_shape_names[] =
+{
+    {blip::input_dead_zone_shape::axial, "Axial"},
+    {blip::input_dead_zone_shape::radial, "Radial"},
+};
+
 }
 
 namespace blip {
@@ -42,38 +53,109 @@ input_signal input_analog_activation::signal() const noexcept
     return input_signal::digital;
 }
 
-void input_analog_activation::apply(float value, input_event& event)
+void input_analog_activation::clear() noexcept
+{
+    condition = input_analog_activation_condition::none;
+    threshold = 0.0f;
+    dead_zone = 0.0f;
+    dead_zone_shape = input_dead_zone_shape::axial;
+    exponent = 1.0f;
+    hysteresis = 0.0f;
+    epsilon = 0.0f;
+}
+
+bool input_analog_activation::apply(
+    float value,
+    input_analog_activation_state& state,
+    input_event& event) const noexcept
+{
+    return apply(value, 0.0f, state, event);
+}
+
+bool input_analog_activation::apply(
+    float value,
+    float paired_value,
+    input_analog_activation_state& state,
+    input_event& event) const noexcept
+{
+    auto processed = process(value, paired_value);
+    if (condition == input_analog_activation_condition::none) {
+        // Returning to rest or reaching the end of the range is always
+        // reported so that small movements cannot leave the value stuck
+        auto is_changed = !state.has_last_value
+            || std::abs(processed - state.last_value) > epsilon
+            || (processed != state.last_value
+                && (processed == 0.0f || std::abs(processed) == 1.0f));
+        if (!is_changed) {
+            return false;
+        }
+        event.value.analog = processed;
+        state.last_value = processed;
+    }
+    else {
+        auto is_active = compare(processed, state);
+        if (state.has_last_value
+            && is_active == (state.last_value != 0.0f))
+        {
+            return false;
+        }
+        event.value.digital = is_active;
+        state.last_value = is_active ? 1.0f : 0.0f;
+    }
+    state.has_last_value = true;
+    return true;
+}
+
+float input_analog_activation::process(float value, float paired_value)
     const noexcept
 {
+    auto magnitude = dead_zone_shape == input_dead_zone_shape::radial
+        ? std::hypot(value, paired_value)
+        : std::abs(value);
+    if (magnitude <= dead_zone || dead_zone >= 1.0f) {
+        return 0.0f;
+    }
+
+    // Rescale the magnitude beyond the dead zone to the full range before
+    // applying the curve, so that there is no jump at the dead zone's edge
+    auto scaled = std::min((magnitude - dead_zone) / (1.0f - dead_zone),
+        1.0f);
+    if (exponent != 1.0f) {
+        scaled = std::pow(scaled, exponent);
+    }
+    return std::max(-1.0f, std::min(value / magnitude * scaled, 1.0f));
+}
+
+bool input_analog_activation::compare(
+    float value,
+    input_analog_activation_state const& state) const noexcept
+{
+    // An active ordering condition stays active until the value moves back
+    // past the threshold by the hysteresis
+    auto is_active = state.has_last_value && state.last_value != 0.0f;
     switch (condition) {
         case input_analog_activation_condition::none:
-            event.value.analog = value;
-            break;
+            return value != 0.0f;
 
         case input_analog_activation_condition::equal:
-            event.value.digital = value == threshold;
-            break;
-            
+            return value == threshold;
+
         case input_analog_activation_condition::not_equal:
-            event.value.digital = value != threshold;
-            break;
-            
+            return value != threshold;
+
         case input_analog_activation_condition::less:
-            event.value.digital = value < threshold;
-            break;
-            
+            return value < threshold + (is_active ? hysteresis : 0.0f);
+
         case input_analog_activation_condition::less_equal:
-            event.value.digital = value <= threshold;
-            break;
-            
+            return value <= threshold + (is_active ? hysteresis : 0.0f);
+
         case input_analog_activation_condition::greater:
-            event.value.digital = value > threshold;
-            break;
-            
+            return value > threshold - (is_active ? hysteresis : 0.0f);
+
         case input_analog_activation_condition::greater_equal:
-            event.value.digital = value >= threshold;
-            break;
+            return value >= threshold - (is_active ? hysteresis : 0.0f);
     }
+    return false;
 }
 
 std::istream& operator>>(
@@ -121,10 +203,51 @@ std::ostream& operator<<(
         "unmapped input_analog_activation_condition_names"};
 }
 
+std::istream& operator>>(std::istream& is, input_dead_zone_shape& rhs)
+{
+    std::istream::sentry sentry{is};
+    if (!sentry) {
+        return is;
+    }
+
+    std::string word;
+    is >> word;
+    if (!is) {
+        return is;
+    }
+
+    for (auto&& pair : input_dead_zone_shape_names) {
+        if (word == pair.second) {
+            rhs = pair.first;
+            return is;
+        }
+    }
+
+    is.setstate(std::ios_base::failbit);
+    return is;
+}
+
+std::ostream& operator<<(std::ostream& os, input_dead_zone_shape rhs)
+{
+    std::ostream::sentry sentry{os};
+    if (!sentry) {
+        return os;
+    }
+
+    for (auto&& pair : input_dead_zone_shape_names) {
+        if (rhs == pair.first) {
+            return os << pair.second;
+        }
+    }
+
+    throw std::logic_error{"unmapped input_dead_zone_shape"};
+}
+
 bool xml_converter<input_analog_activation>::deserialize(
     xml_deserializer& dx,
     input_analog_activation& t)
 {
+    t.clear();
     if (!dx.attribute("Condition", t.condition)) {
         return false;
     }
@@ -133,6 +256,13 @@ bool xml_converter<input_analog_activation>::deserialize(
             return false;
         }
     }
+
+    // Filtering parameters are optional and keep their defaults if absent
+    dx.attribute("DeadZone", t.dead_zone);
+    dx.attribute("DeadZoneShape", t.dead_zone_shape);
+    dx.attribute("Exponent", t.exponent);
+    dx.attribute("Hysteresis", t.hysteresis);
+    dx.attribute("Epsilon", t.epsilon);
     return true;
 }
 
@@ -144,6 +274,21 @@ bool xml_converter<input_analog_activation>::serialize(
     if (t.condition != input_analog_activation_condition::none) {
         sx.attribute("Threshold", t.threshold);
     }
+    if (t.dead_zone != 0.0f) {
+        sx.attribute("DeadZone", t.dead_zone);
+    }
+    if (t.dead_zone_shape != input_dead_zone_shape::axial) {
+        sx.attribute("DeadZoneShape", t.dead_zone_shape);
+    }
+    if (t.exponent != 1.0f) {
+        sx.attribute("Exponent", t.exponent);
+    }
+    if (t.hysteresis != 0.0f) {
+        sx.attribute("Hysteresis", t.hysteresis);
+    }
+    if (t.epsilon != 0.0f) {
+        sx.attribute("Epsilon", t.epsilon);
+    }
     return true;
 }
 
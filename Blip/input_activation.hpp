@@ -31,7 +31,35 @@ enum class input_analog_activation_condition
     greater_equal, //!< Digital true if value is greater or equal to thresold
 };
 
+/// \brief Possible shapes of an analog dead zone
+enum class input_dead_zone_shape
+{
+    axial, //!< Dead zone applies to each axis independently
+    radial, //!< Dead zone applies to the magnitude of an axis pair
+};
+
+/// \brief Runtime state of an \ref input_analog_activation
+///
+/// A value-initialized state is that of an activation that has not yet
+/// produced an event.
+struct input_analog_activation_state
+{
+    float last_value; //!< Processed value of the last produced event
+    bool has_last_value; //!< Whether an event has been produced
+};
+
 /// \brief Activation parameters for an analog signal
+///
+/// Values are processed by applying the dead zone, rescaling the remainder
+/// to the full range, and applying the response curve. The processed value
+/// is then either produced directly or compared against the threshold.
+///
+/// To reduce the number of events produced by noisy controls, an event is
+/// produced only when the processed value moves by more than \ref epsilon,
+/// or, for digital activations, when the activation state changes. The
+/// last produced value is kept for this purpose in an
+/// \ref input_analog_activation_state owned by the caller, so that the
+/// parameters themselves never change as values are applied.
 struct input_analog_activation
 {
     /// \brief The condition under which activation occurs
@@ -40,14 +68,69 @@ struct input_analog_activation
     /// \brief The threshold at which digital activation occurs
     float threshold;
 
+    /// \brief Magnitude at or below which the value is treated as zero
+    float dead_zone;
+
+    /// \brief Shape of the dead zone
+    input_dead_zone_shape dead_zone_shape;
+
+    /// \brief Exponent of the response curve
+    ///
+    /// 1 is linear; greater values give finer control near the center.
+    float exponent;
+
+    /// \brief Distance past the threshold that the value must move back
+    /// before an active ordering condition deactivates
+    float hysteresis;
+
+    /// \brief Change in the processed value needed to produce an event
+    float epsilon;
+
+    /// \brief Resets the parameters so that values pass through unchanged
+    void clear() noexcept;
+
     /// \brief Gets the type of signal produced when the condition activates
     /// \return type of signal
     input_signal signal() const noexcept;
 
-    /// \brief Applies the activation a signal value
+    /// \brief Applies the activation to a signal value
     /// \param value signal value
+    /// \param state state of the activation, updated if an event is
+    /// produced
     /// \param event event to store the result in
-    void apply(float value, input_event& event) const noexcept;
+    /// \return whether an event should be produced
+    bool apply(
+        float value,
+        input_analog_activation_state& state,
+        input_event& event) const noexcept;
+
+    /// \brief Applies the activation to a signal value paired with another
+    /// \param value signal value
+    /// \param paired_value value of the paired signal, which contributes to
+    /// a radial dead zone
+    /// \param state state of the activation, updated if an event is
+    /// produced
+    /// \param event event to store the result in
+    /// \return whether an event should be produced
+    bool apply(
+        float value,
+        float paired_value,
+        input_analog_activation_state& state,
+        input_event& event) const noexcept;
+
+private:
+    /// \brief Applies the dead zone and response curve to a value
+    /// \param value signal value
+    /// \param paired_value value of the paired signal
+    /// \return processed value
+    float process(float value, float paired_value) const noexcept;
+
+    /// \brief Compares a processed value against the threshold
+    /// \param value processed value
+    /// \param state state of the activation
+    /// \return whether the condition activates
+    bool compare(float value, input_analog_activation_state const& state)
+        const noexcept;
 };
 
 /// \brief Inputs a \ref input_analog_activation_condition from a
@@ -68,6 +151,18 @@ std::ostream& operator<<(
     std::ostream& os,
     input_analog_activation_condition rhs);
 
+/// \brief Inputs a \ref input_dead_zone_shape from a \ref std::istream
+/// \param is stream to input from
+/// \param rhs value to input
+/// \return \p is
+std::istream& operator>>(std::istream& is, input_dead_zone_shape& rhs);
+
+/// \brief Ouputs a \ref input_dead_zone_shape to a \ref std::ostream
+/// \param os stream to output to
+/// \param rhs value to output
+/// \return \p os
+std::ostream& operator<<(std::ostream& os, input_dead_zone_shape rhs);
+
 /// \}
 
 /// \addtogroup xml
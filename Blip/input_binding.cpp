@@ -11,6 +11,7 @@
 #include "blip/xml_deserializer.hpp"
 #include "blip/xml_serializer.hpp"
 #include <SFML/Window/Event.hpp>
+#include <cmath>
 #include <istream>
 #include <ostream>
 #include <stdexcept>
@@ -24,6 +25,8 @@ input_device_names[] =
 {
     {blip::input_device::controller, "Controller"},
     {blip::input_device::keyboard, "Keyboard"},
+    {blip::input_device::mouse, "Mouse"},
+    {blip::input_device::touch, "Touch"},
 };
 
 /// \brief Mapping between \ref blip::input_controller_control values and
@@ -35,6 +38,115 @@ input_controller_control_names[] =
     {blip::input_controller_control::button, "Button"},
 };
 
+/// \brief Mapping between \ref blip::input_keyboard_control values and
+/// their names
+constexpr std::pair<blip::input_keyboard_control, char const*>
+input_keyboard_control_names[] =
+{
+    {blip::input_keyboard_control::key, "Key"},
+    {blip::input_keyboard_control::chord, "Chord"},
+    {blip::input_keyboard_control::sequence, "Sequence"},
+};
+
+/// \brief Mapping between \ref blip::input_mouse_control values and their
+/// names
+constexpr std::pair<blip::input_mouse_control, char const*>
+input_mouse_control_names[] =
+{
+    {blip::input_mouse_control::axis, "Axis"},
+    {blip::input_mouse_control::button, "Button"},
+    {blip::input_mouse_control::wheel, "Wheel"},
+};
+
+/// \brief Sources of events distinguished by dispatch keys
+enum class dispatch_source : blip::input_dispatch_key
+{
+    keyboard_key, //!< Keyboard key press or release
+    controller_button, //!< Controller button press or release
+    controller_axis, //!< Controller axis movement
+    mouse_button, //!< Mouse button press or release
+    mouse_wheel, //!< Mouse wheel scroll
+    mouse_move, //!< Mouse movement along either axis
+    touch, //!< Touch beginning or ending
+};
+
+/// \brief Makes a dispatch key
+/// \param source source of the events
+/// \param code key, button, or axis code of the events
+/// \return dispatch key
+constexpr blip::input_dispatch_key make_dispatch_key(
+    dispatch_source source,
+    unsigned code) noexcept
+{
+    return static_cast<blip::input_dispatch_key>(source) << 32 | code;
+}
+
+/// \brief Gets the bit mask of the positions of a key in a key list
+/// \param keys list of keys
+/// \param code code of the key
+/// \return bit mask with a bit set for each position holding \p code
+unsigned key_mask(blip::input_key_list const& keys, unsigned code) noexcept
+{
+    unsigned mask{0};
+    for (std::size_t i = 0; i < keys.size; ++i) {
+        if (keys.codes[i] == code) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+/// \brief Gets the dispatch keys of every key in a key list but the last
+/// \param keys list of keys
+/// \param to array of \ref blip::max_observed_dispatch_keys keys to store
+/// the dispatch keys in
+/// \return number of keys stored
+///
+/// The last key is the one a binding is dispatched by, so it and repeated
+/// keys are skipped in order for an event to reach the binding only once.
+std::size_t observed_key_list(
+    blip::input_key_list const& keys,
+    blip::input_dispatch_key* to) noexcept
+{
+    if (keys.size == 0) {
+        return 0;
+    }
+    auto last = keys.codes[keys.size - 1];
+    std::size_t count{0};
+    for (std::size_t i = 0; i + 1 < keys.size; ++i) {
+        auto code = keys.codes[i];
+        if (code == last || (key_mask(keys, code) & ((1u << i) - 1)) != 0) {
+            continue;
+        }
+        to[count++] = make_dispatch_key(dispatch_source::keyboard_key, code);
+    }
+    return count;
+}
+
+/// \brief Gets the key code and state of a keyboard event
+/// \param from source SFML event
+/// \param code code of the key
+/// \param is_pressed whether the key was pressed
+/// \return whether the event is a key press or release
+bool key_event(sf::Event const& from, unsigned& code, bool& is_pressed)
+    noexcept
+{
+    switch (from.type) {
+        case sf::Event::KeyPressed:
+            is_pressed = true;
+            break;
+
+        case sf::Event::KeyReleased:
+            is_pressed = false;
+            break;
+
+        default:
+            return false;
+    }
+    code = static_cast<unsigned>(from.key.code);
+    return true;
+}
+
 }
 
 namespace blip {
@@ -44,18 +156,44 @@ input_signal input_controller_axis_binding::signal() const noexcept
     return activation.signal();
 }
 
+input_dispatch_key input_controller_axis_binding::dispatch_key()
+    const noexcept
+{
+    return make_dispatch_key(dispatch_source::controller_axis, code);
+}
+
+std::size_t input_controller_axis_binding::observed_dispatch_keys(
+    input_dispatch_key* keys) const noexcept
+{
+    if (!is_paired || paired_code == code) {
+        return 0;
+    }
+    keys[0] = make_dispatch_key(dispatch_source::controller_axis, paired_code);
+    return 1;
+}
+
 bool input_controller_axis_binding::map(
     sf::Event const& from,
+    input_binding_state& state,
     input_event& to) const
 {
     if (from.type != sf::Event::JoystickMoved) {
         return false;
     }
-    if (static_cast<decltype(code)>(from.joystickMove.axis) != code) {
+    auto axis = static_cast<decltype(code)>(from.joystickMove.axis);
+    if (axis == code) {
+        state.position = from.joystickMove.position / 100.0f;
+    }
+    else if (is_paired && axis == paired_code) {
+        // Moving the paired axis can move this axis out of a radial dead
+        // zone, so it is reprocessed as well
+        state.paired_position = from.joystickMove.position / 100.0f;
+    }
+    else {
         return false;
     }
-    activation.apply(from.joystickMove.position / 100.0f, to);
-    return true;
+    return activation.apply(state.position, state.paired_position,
+        state.activation, to);
 }
 
 input_signal input_controller_button_binding::signal() const noexcept
@@ -63,6 +201,12 @@ input_signal input_controller_button_binding::signal() const noexcept
     return input_signal::digital;
 }
 
+input_dispatch_key input_controller_button_binding::dispatch_key()
+    const noexcept
+{
+    return make_dispatch_key(dispatch_source::controller_button, code);
+}
+
 bool input_controller_button_binding::map(
     sf::Event const& from,
     input_event& to) const
@@ -96,67 +240,790 @@ input_signal input_controller_binding::signal() const noexcept
     }
 }
 
-bool input_controller_binding::map(sf::Event const& from, input_event& to)
-    const
+input_dispatch_key input_controller_binding::dispatch_key() const noexcept
+{
+    switch (control) {
+        case input_controller_control::axis:
+            return axis.dispatch_key();
+
+        case input_controller_control::button:
+            return button.dispatch_key();
+    }
+}
+
+std::size_t input_controller_binding::observed_dispatch_keys(
+    input_dispatch_key* keys) const noexcept
 {
     switch (control) {
         case input_controller_control::axis:
-            return axis.map(from, to);
+            return axis.observed_dispatch_keys(keys);
+
+        case input_controller_control::button:
+            return 0;
+    }
+}
+
+bool input_controller_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    switch (control) {
+        case input_controller_control::axis:
+            return axis.map(from, state, to);
 
         case input_controller_control::button:
             return button.map(from, to);
     }
 }
 
+input_signal input_keyboard_key_binding::signal() const noexcept
+{
+    return input_signal::digital;
+}
+
+input_dispatch_key input_keyboard_key_binding::dispatch_key() const noexcept
+{
+    return make_dispatch_key(dispatch_source::keyboard_key, code);
+}
+
+bool input_keyboard_key_binding::map(sf::Event const& from, input_event& to)
+    const
+{
+    unsigned key;
+    if (!key_event(from, key, to.value.digital) || key != code) {
+        return false;
+    }
+    return true;
+}
+
+input_signal input_keyboard_chord_binding::signal() const noexcept
+{
+    return input_signal::digital;
+}
+
+input_dispatch_key input_keyboard_chord_binding::dispatch_key()
+    const noexcept
+{
+    return make_dispatch_key(dispatch_source::keyboard_key,
+        keys.size > 0 ? keys.codes[keys.size - 1] : 0);
+}
+
+std::size_t input_keyboard_chord_binding::observed_dispatch_keys(
+    input_dispatch_key* keys) const noexcept
+{
+    return observed_key_list(this->keys, keys);
+}
+
+bool input_keyboard_chord_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    unsigned code;
+    bool is_pressed;
+    if (!key_event(from, code, is_pressed)) {
+        return false;
+    }
+    auto mask = key_mask(keys, code);
+    if (mask == 0) {
+        return false;
+    }
+
+    // Only a change in whether every key is held produces an event, so key
+    // repeats and the other keys of the chord are absorbed
+    auto all = (1u << keys.size) - 1;
+    auto was_down = state.held == all;
+    state.held = is_pressed ? state.held | mask : state.held & ~mask;
+    auto is_down = state.held == all;
+    if (is_down == was_down) {
+        return false;
+    }
+    to.value.digital = is_down;
+    return true;
+}
+
+input_signal input_keyboard_sequence_binding::signal() const noexcept
+{
+    return input_signal::digital;
+}
+
+input_dispatch_key input_keyboard_sequence_binding::dispatch_key()
+    const noexcept
+{
+    return make_dispatch_key(dispatch_source::keyboard_key,
+        keys.size > 0 ? keys.codes[keys.size - 1] : 0);
+}
+
+std::size_t input_keyboard_sequence_binding::observed_dispatch_keys(
+    input_dispatch_key* keys) const noexcept
+{
+    return observed_key_list(this->keys, keys);
+}
+
+void input_keyboard_sequence_binding::advance(
+    float time_step,
+    input_binding_state& state) const noexcept
+{
+    if (state.step == 0) {
+        return;
+    }
+    state.elapsed += time_step;
+    if (state.elapsed > interval) {
+        state.step = 0;
+    }
+}
+
+void input_keyboard_sequence_binding::interrupt(
+    sf::Event const& from,
+    input_binding_state& state) const noexcept
+{
+    // The keys of the sequence are dispatched to the binding, which decides
+    // for itself whether they continue the sequence
+    unsigned code;
+    bool is_pressed;
+    if (key_event(from, code, is_pressed) && is_pressed
+        && key_mask(keys, code) == 0)
+    {
+        state.step = 0;
+    }
+}
+
+bool input_keyboard_sequence_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    unsigned code;
+    bool is_pressed;
+    if (!key_event(from, code, is_pressed)) {
+        return false;
+    }
+    auto mask = key_mask(keys, code);
+    if (mask == 0) {
+        return false;
+    }
+
+    if (!is_pressed) {
+        state.held &= ~mask;
+        if (!state.is_down || code != keys.codes[keys.size - 1]) {
+            return false;
+        }
+        state.is_down = false;
+        to.value.digital = false;
+        return true;
+    }
+
+    // Key repeats are not new presses and must not advance the sequence
+    if ((state.held & mask) != 0) {
+        return false;
+    }
+    state.held |= mask;
+    if (state.is_down) {
+        return false;
+    }
+
+    if (state.step > 0 && keys.codes[state.step] == code) {
+        ++state.step;
+    }
+    else {
+        state.step = keys.codes[0] == code ? 1 : 0;
+    }
+    state.elapsed = 0.0f;
+    if (state.step < keys.size) {
+        return false;
+    }
+    state.step = 0;
+    state.is_down = true;
+    to.value.digital = true;
+    return true;
+}
+
 input_signal input_keyboard_binding::signal() const noexcept
+{
+    switch (control) {
+        case input_keyboard_control::key:
+            return key.signal();
+
+        case input_keyboard_control::chord:
+            return chord.signal();
+
+        case input_keyboard_control::sequence:
+            return sequence.signal();
+    }
+}
+
+input_dispatch_key input_keyboard_binding::dispatch_key() const noexcept
+{
+    switch (control) {
+        case input_keyboard_control::key:
+            return key.dispatch_key();
+
+        case input_keyboard_control::chord:
+            return chord.dispatch_key();
+
+        case input_keyboard_control::sequence:
+            return sequence.dispatch_key();
+    }
+}
+
+std::size_t input_keyboard_binding::observed_dispatch_keys(
+    input_dispatch_key* keys) const noexcept
+{
+    switch (control) {
+        case input_keyboard_control::key:
+            return 0;
+
+        case input_keyboard_control::chord:
+            return chord.observed_dispatch_keys(keys);
+
+        case input_keyboard_control::sequence:
+            return sequence.observed_dispatch_keys(keys);
+    }
+}
+
+bool input_keyboard_binding::is_timed() const noexcept
+{
+    return control == input_keyboard_control::sequence;
+}
+
+bool input_keyboard_binding::advance(
+    float time_step,
+    input_binding_state& state,
+    input_event&) const noexcept
+{
+    if (control == input_keyboard_control::sequence) {
+        sequence.advance(time_step, state);
+    }
+    return false;
+}
+
+void input_keyboard_binding::interrupt(
+    sf::Event const& from,
+    input_binding_state& state) const noexcept
+{
+    if (control == input_keyboard_control::sequence) {
+        sequence.interrupt(from, state);
+    }
+}
+
+bool input_keyboard_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    switch (control) {
+        case input_keyboard_control::key:
+            return key.map(from, to);
+
+        case input_keyboard_control::chord:
+            return chord.map(from, state, to);
+
+        case input_keyboard_control::sequence:
+            return sequence.map(from, state, to);
+    }
+}
+
+input_signal input_mouse_axis_binding::signal() const noexcept
+{
+    return activation.signal();
+}
+
+input_dispatch_key input_mouse_axis_binding::dispatch_key() const noexcept
+{
+    // Every movement reports both axes, so all axes share a key
+    return make_dispatch_key(dispatch_source::mouse_move, 0);
+}
+
+bool input_mouse_axis_binding::advance(
+    input_binding_state& state,
+    input_event& to) const noexcept
+{
+    // No event is produced when the mouse stops, so an axis still deflected
+    // by the last movement is returned to rest on the following frame
+    if (!state.activation.has_last_value) {
+        return false;
+    }
+    return activation.apply(0.0f, state.activation, to);
+}
+
+bool input_mouse_axis_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    if (from.type != sf::Event::MouseMoved || code > 1) {
+        return false;
+    }
+    auto next = static_cast<float>(code == 0
+        ? from.mouseMove.x
+        : from.mouseMove.y);
+    auto delta = state.has_position ? next - state.position : 0.0f;
+    state.position = next;
+    state.has_position = true;
+    return activation.apply(delta * scale, state.activation, to);
+}
+
+input_signal input_mouse_button_binding::signal() const noexcept
 {
     return input_signal::digital;
 }
 
-bool input_keyboard_binding::map(sf::Event const& from, input_event& to)
+input_dispatch_key input_mouse_button_binding::dispatch_key() const noexcept
+{
+    return make_dispatch_key(dispatch_source::mouse_button, code);
+}
+
+bool input_mouse_button_binding::map(sf::Event const& from, input_event& to)
     const
 {
     switch (from.type) {
-        case sf::Event::KeyPressed:
+        case sf::Event::MouseButtonPressed:
             to.value.digital = true;
             break;
 
-        case sf::Event::KeyReleased:
+        case sf::Event::MouseButtonReleased:
+            to.value.digital = false;
+            break;
+
+        default:
+            return false;
+    }
+    if (static_cast<decltype(code)>(from.mouseButton.button) != code) {
+        return false;
+    }
+    return true;
+}
+
+input_signal input_mouse_wheel_binding::signal() const noexcept
+{
+    return activation.signal();
+}
+
+input_dispatch_key input_mouse_wheel_binding::dispatch_key() const noexcept
+{
+    return make_dispatch_key(dispatch_source::mouse_wheel, code);
+}
+
+bool input_mouse_wheel_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    if (from.type != sf::Event::MouseWheelScrolled) {
+        return false;
+    }
+    if (static_cast<decltype(code)>(from.mouseWheelScroll.wheel) != code) {
+        return false;
+    }
+    return activation.apply(from.mouseWheelScroll.delta, state.activation,
+        to);
+}
+
+input_signal input_mouse_binding::signal() const noexcept
+{
+    switch (control) {
+        case input_mouse_control::axis:
+            return axis.signal();
+
+        case input_mouse_control::button:
+            return button.signal();
+
+        case input_mouse_control::wheel:
+            return wheel.signal();
+    }
+}
+
+input_dispatch_key input_mouse_binding::dispatch_key() const noexcept
+{
+    switch (control) {
+        case input_mouse_control::axis:
+            return axis.dispatch_key();
+
+        case input_mouse_control::button:
+            return button.dispatch_key();
+
+        case input_mouse_control::wheel:
+            return wheel.dispatch_key();
+    }
+}
+
+bool input_mouse_binding::is_timed() const noexcept
+{
+    return control == input_mouse_control::axis;
+}
+
+bool input_mouse_binding::advance(
+    input_binding_state& state,
+    input_event& to) const noexcept
+{
+    if (control == input_mouse_control::axis) {
+        return axis.advance(state, to);
+    }
+    return false;
+}
+
+bool input_mouse_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    switch (control) {
+        case input_mouse_control::axis:
+            return axis.map(from, state, to);
+
+        case input_mouse_control::button:
+            return button.map(from, to);
+
+        case input_mouse_control::wheel:
+            return wheel.map(from, state, to);
+    }
+}
+
+input_signal input_touch_binding::signal() const noexcept
+{
+    return input_signal::digital;
+}
+
+input_dispatch_key input_touch_binding::dispatch_key() const noexcept
+{
+    return make_dispatch_key(dispatch_source::touch, finger);
+}
+
+bool input_touch_binding::map(sf::Event const& from, input_event& to) const
+{
+    switch (from.type) {
+        case sf::Event::TouchBegan:
+            to.value.digital = true;
+            break;
+
+        case sf::Event::TouchEnded:
             to.value.digital = false;
             break;
 
-        default:
-            return false;
+        default:
+            return false;
+    }
+    if (from.touch.finger != finger) {
+        return false;
+    }
+    return true;
+}
+
+input_signal input_binding::signal() const noexcept
+{
+    switch (device) {
+        case input_device::controller:
+            return controller.signal();
+
+        case input_device::keyboard:
+            return keyboard.signal();
+
+        case input_device::mouse:
+            return mouse.signal();
+
+        case input_device::touch:
+            return touch.signal();
+    }
+}
+
+input_dispatch_key input_binding::dispatch_key() const noexcept
+{
+    switch (device) {
+        case input_device::controller:
+            return controller.dispatch_key();
+
+        case input_device::keyboard:
+            return keyboard.dispatch_key();
+
+        case input_device::mouse:
+            return mouse.dispatch_key();
+
+        case input_device::touch:
+            return touch.dispatch_key();
+    }
+}
+
+std::size_t input_binding::observed_dispatch_keys(
+    input_dispatch_key* keys) const noexcept
+{
+    switch (device) {
+        case input_device::controller:
+            return controller.observed_dispatch_keys(keys);
+
+        case input_device::keyboard:
+            return keyboard.observed_dispatch_keys(keys);
+
+        case input_device::mouse:
+        case input_device::touch:
+            return 0;
+    }
+}
+
+bool input_binding::is_timed() const noexcept
+{
+    switch (device) {
+        case input_device::keyboard:
+            return keyboard.is_timed();
+
+        case input_device::mouse:
+            return mouse.is_timed();
+
+        case input_device::controller:
+        case input_device::touch:
+            return false;
+    }
+}
+
+bool input_binding::advance(
+    float time_step,
+    input_binding_state& state,
+    input_event& to) const noexcept
+{
+    switch (device) {
+        case input_device::keyboard:
+            return keyboard.advance(time_step, state, to);
+
+        case input_device::mouse:
+            return mouse.advance(state, to);
+
+        case input_device::controller:
+        case input_device::touch:
+            return false;
+    }
+}
+
+void input_binding::interrupt(
+    sf::Event const& from,
+    input_binding_state& state) const noexcept
+{
+    if (device == input_device::keyboard) {
+        keyboard.interrupt(from, state);
+    }
+}
+
+bool input_binding::map(
+    sf::Event const& from,
+    input_binding_state& state,
+    input_event& to) const
+{
+    switch (device) {
+        case input_device::controller:
+            return controller.map(from, state, to);
+
+        case input_device::keyboard:
+            return keyboard.map(from, state, to);
+
+        case input_device::mouse:
+            return mouse.map(from, state, to);
+
+        case input_device::touch:
+            return touch.map(from, to);
+    }
+}
+
+bool dispatch_key(sf::Event const& event, input_dispatch_key& key) noexcept
+{
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:
+            key = make_dispatch_key(dispatch_source::keyboard_key,
+                static_cast<unsigned>(event.key.code));
+            return true;
+
+        case sf::Event::JoystickButtonPressed:
+        case sf::Event::JoystickButtonReleased:
+            key = make_dispatch_key(dispatch_source::controller_button,
+                event.joystickButton.button);
+            return true;
+
+        case sf::Event::JoystickMoved:
+            key = make_dispatch_key(dispatch_source::controller_axis,
+                static_cast<unsigned>(event.joystickMove.axis));
+            return true;
+
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+            key = make_dispatch_key(dispatch_source::mouse_button,
+                static_cast<unsigned>(event.mouseButton.button));
+            return true;
+
+        case sf::Event::MouseWheelScrolled:
+            key = make_dispatch_key(dispatch_source::mouse_wheel,
+                static_cast<unsigned>(event.mouseWheelScroll.wheel));
+            return true;
+
+        case sf::Event::MouseMoved:
+            key = make_dispatch_key(dispatch_source::mouse_move, 0);
+            return true;
+
+        case sf::Event::TouchBegan:
+        case sf::Event::TouchEnded:
+            key = make_dispatch_key(dispatch_source::touch,
+                event.touch.finger);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+bool capture_binding(
+    sf::Event const& from,
+    input_signal signal,
+    input_binding& to) noexcept
+{
+    // Analog controls produce digital signals through an activation in the
+    // direction they were moved
+    auto capture_analog = [signal](float value, input_analog_activation& a)
+    {
+        a.clear();
+        if (signal == input_signal::digital) {
+            a.condition = value < 0.0f
+                ? input_analog_activation_condition::less
+                : input_analog_activation_condition::greater;
+            a.threshold = value < 0.0f
+                ? -capture_axis_threshold
+                : capture_axis_threshold;
+        }
+    };
+
+    switch (from.type) {
+        case sf::Event::KeyPressed:
+            to.device = input_device::keyboard;
+            to.keyboard.control = input_keyboard_control::key;
+            to.keyboard.key.code = static_cast<unsigned>(from.key.code);
+            break;
+
+        case sf::Event::JoystickButtonPressed:
+            to.device = input_device::controller;
+            to.controller.control = input_controller_control::button;
+            to.controller.button.code = from.joystickButton.button;
+            break;
+
+        case sf::Event::JoystickMoved: {
+            auto position = from.joystickMove.position / 100.0f;
+            if (std::abs(position) < capture_axis_threshold) {
+                return false;
+            }
+            to.device = input_device::controller;
+            to.controller.control = input_controller_control::axis;
+            auto& axis = to.controller.axis;
+            axis.code = static_cast<unsigned>(from.joystickMove.axis);
+            axis.is_paired = false;
+            axis.paired_code = 0;
+            capture_analog(position, axis.activation);
+            return true;
+        }
+
+        case sf::Event::MouseButtonPressed:
+            to.device = input_device::mouse;
+            to.mouse.control = input_mouse_control::button;
+            to.mouse.button.code =
+                static_cast<unsigned>(from.mouseButton.button);
+            break;
+
+        case sf::Event::MouseWheelScrolled: {
+            to.device = input_device::mouse;
+            to.mouse.control = input_mouse_control::wheel;
+            auto& wheel = to.mouse.wheel;
+            wheel.code = static_cast<unsigned>(from.mouseWheelScroll.wheel);
+            capture_analog(from.mouseWheelScroll.delta, wheel.activation);
+            return true;
+        }
+
+        case sf::Event::TouchBegan:
+            to.device = input_device::touch;
+            to.touch.finger = from.touch.finger;
+            break;
+
+        default:
+            return false;
+    }
+    return signal == input_signal::digital;
+}
+
+std::istream& operator>>(std::istream& is, input_device& rhs)
+{
+    std::istream::sentry sentry{is};
+    if (!sentry) {
+        return is;
+    }
+
+    std::string word;
+    is >> word;
+    if (!is) {
+        return is;
+    }
+
+    for (auto&& pair : input_device_names) {
+        if (word == pair.second) {
+            rhs = pair.first;
+            return is;
+        }
+    }
+
+    is.setstate(std::ios_base::failbit);
+    return is;
+}
+
+std::ostream& operator<<(std::ostream& os, input_device rhs)
+{
+    std::ostream::sentry sentry{os};
+    if (!sentry) {
+        return os;
     }
-    if (static_cast<decltype(code)>(from.key.code) != code) {
-        return false;
+
+    for (auto&& pair : input_device_names) {
+        if (rhs == pair.first) {
+            return os << pair.second;
+        }
     }
-    return true;
+
+    throw std::logic_error{"unmapped input_device"};
 }
 
-input_signal input_binding::signal() const noexcept
+std::istream& operator>>(std::istream& is, input_controller_control& rhs)
 {
-    switch (device) {
-        case input_device::controller:
-            return controller.signal();
+    std::istream::sentry sentry{is};
+    if (!sentry) {
+        return is;
+    }
 
-        case input_device::keyboard:
-            return keyboard.signal();
+    std::string word;
+    is >> word;
+    if (!is) {
+        return is;
+    }
+
+    for (auto&& pair : input_controller_control_names) {
+        if (word == pair.second) {
+            rhs = pair.first;
+            return is;
+        }
     }
+
+    is.setstate(std::ios_base::failbit);
+    return is;
 }
 
-bool input_binding::map(sf::Event const& from, input_event& to) const
+std::ostream& operator<<(std::ostream& os, input_controller_control rhs)
 {
-    switch (device) {
-        case input_device::controller:
-            return controller.map(from, to);
+    std::ostream::sentry sentry{os};
+    if (!sentry) {
+        return os;
+    }
 
-        case input_device::keyboard:
-            return keyboard.map(from, to);
+    for (auto&& pair : input_controller_control_names) {
+        if (rhs == pair.first) {
+            return os << pair.second;
+        }
     }
+
+    throw std::logic_error{"unmapped input_controller_control"};
 }
 
-std::istream& operator>>(std::istream& is, input_device& rhs)
+std::istream& operator>>(std::istream& is, input_keyboard_control& rhs)
 {
     std::istream::sentry sentry{is};
     if (!sentry) {
@@ -169,7 +1036,7 @@ std::istream& operator>>(std::istream& is, input_device& rhs)
         return is;
     }
 
-    for (auto&& pair : input_device_names) {
+    for (auto&& pair : input_keyboard_control_names) {
         if (word == pair.second) {
             rhs = pair.first;
             return is;
@@ -180,23 +1047,67 @@ std::istream& operator>>(std::istream& is, input_device& rhs)
     return is;
 }
 
-std::ostream& operator<<(std::ostream& os, input_device rhs)
+std::ostream& operator<<(std::ostream& os, input_keyboard_control rhs)
 {
     std::ostream::sentry sentry{os};
     if (!sentry) {
         return os;
     }
 
-    for (auto&& pair : input_device_names) {
+    for (auto&& pair : input_keyboard_control_names) {
         if (rhs == pair.first) {
             return os << pair.second;
         }
     }
 
-    throw std::logic_error{"unmapped input_device"};
+    throw std::logic_error{"unmapped input_keyboard_control"};
 }
 
-std::istream& operator>>(std::istream& is, input_controller_control& rhs)
+std::istream& operator>>(std::istream& is, input_key_list& rhs)
+{
+    std::istream::sentry sentry{is};
+    if (!sentry) {
+        return is;
+    }
+
+    input_key_list list{};
+    unsigned code;
+    while (is >> code) {
+        if (list.size == input_key_list::capacity) {
+            is.setstate(std::ios_base::failbit);
+            return is;
+        }
+        list.codes[list.size++] = code;
+    }
+    if (list.size == 0 || !is.eof()) {
+        is.setstate(std::ios_base::failbit);
+        return is;
+    }
+
+    // Reaching the end of the list sets the fail bit along with the end of
+    // file bit, but the list itself was read successfully
+    is.clear(std::ios_base::eofbit);
+    rhs = list;
+    return is;
+}
+
+std::ostream& operator<<(std::ostream& os, input_key_list const& rhs)
+{
+    std::ostream::sentry sentry{os};
+    if (!sentry) {
+        return os;
+    }
+
+    for (std::size_t i = 0; i < rhs.size; ++i) {
+        if (i > 0) {
+            os << ' ';
+        }
+        os << rhs.codes[i];
+    }
+    return os;
+}
+
+std::istream& operator>>(std::istream& is, input_mouse_control& rhs)
 {
     std::istream::sentry sentry{is};
     if (!sentry) {
@@ -209,7 +1120,7 @@ std::istream& operator>>(std::istream& is, input_controller_control& rhs)
         return is;
     }
 
-    for (auto&& pair : input_controller_control_names) {
+    for (auto&& pair : input_mouse_control_names) {
         if (word == pair.second) {
             rhs = pair.first;
             return is;
@@ -220,20 +1131,20 @@ std::istream& operator>>(std::istream& is, input_controller_control& rhs)
     return is;
 }
 
-std::ostream& operator<<(std::ostream& os, input_controller_control rhs)
+std::ostream& operator<<(std::ostream& os, input_mouse_control rhs)
 {
     std::ostream::sentry sentry{os};
     if (!sentry) {
         return os;
     }
 
-    for (auto&& pair : input_controller_control_names) {
+    for (auto&& pair : input_mouse_control_names) {
         if (rhs == pair.first) {
             return os << pair.second;
         }
     }
 
-    throw std::logic_error{"unmapped input_controller_control"};
+    throw std::logic_error{"unmapped input_mouse_control"};
 }
 
 bool xml_converter<input_controller_axis_binding>::deserialize(
@@ -243,6 +1154,7 @@ bool xml_converter<input_controller_axis_binding>::deserialize(
     if (!dx.attribute("Code", t.code)) {
         return false;
     }
+    t.is_paired = dx.attribute("PairedCode", t.paired_code);
     auto child = dx.child("Activation");
     if (child) {
         if (!dx.child(child.node, t.activation)) {
@@ -250,7 +1162,7 @@ bool xml_converter<input_controller_axis_binding>::deserialize(
         }
     }
     else {
-        t.activation.condition = input_analog_activation_condition::none;
+        t.activation.clear();
     }
     return true;
 }
@@ -260,9 +1172,10 @@ bool xml_converter<input_controller_axis_binding>::serialize(
     input_controller_axis_binding const& t)
 {
     sx.attribute("Code", t.code);
-    if (t.activation.condition != input_analog_activation_condition::none) {
-        sx.child("Activation", t.activation);
+    if (t.is_paired) {
+        sx.attribute("PairedCode", t.paired_code);
     }
+    sx.child("Activation", t.activation);
     return true;
 }
 
@@ -323,9 +1236,9 @@ bool xml_converter<input_controller_binding>::serialize(
     }
 }
 
-bool xml_converter<input_keyboard_binding>::deserialize(
+bool xml_converter<input_keyboard_key_binding>::deserialize(
     xml_deserializer& dx,
-    input_keyboard_binding& t)
+    input_keyboard_key_binding& t)
 {
     if (!dx.attribute("Code", t.code)) {
         return false;
@@ -333,11 +1246,251 @@ bool xml_converter<input_keyboard_binding>::deserialize(
     return true;
 }
 
+bool xml_converter<input_keyboard_key_binding>::serialize(
+    xml_serializer& sx,
+    input_keyboard_key_binding const& t)
+{
+    sx.attribute("Code", t.code);
+    return true;
+}
+
+bool xml_converter<input_keyboard_chord_binding>::deserialize(
+    xml_deserializer& dx,
+    input_keyboard_chord_binding& t)
+{
+    if (!dx.attribute("Codes", t.keys)) {
+        return false;
+    }
+    return true;
+}
+
+bool xml_converter<input_keyboard_chord_binding>::serialize(
+    xml_serializer& sx,
+    input_keyboard_chord_binding const& t)
+{
+    sx.attribute("Codes", t.keys);
+    return true;
+}
+
+bool xml_converter<input_keyboard_sequence_binding>::deserialize(
+    xml_deserializer& dx,
+    input_keyboard_sequence_binding& t)
+{
+    if (!dx.attribute("Codes", t.keys)) {
+        return false;
+    }
+    t.interval = input_keyboard_sequence_binding::default_interval;
+    dx.attribute("Interval", t.interval);
+    return true;
+}
+
+bool xml_converter<input_keyboard_sequence_binding>::serialize(
+    xml_serializer& sx,
+    input_keyboard_sequence_binding const& t)
+{
+    sx.attribute("Codes", t.keys);
+    if (t.interval != input_keyboard_sequence_binding::default_interval) {
+        sx.attribute("Interval", t.interval);
+    }
+    return true;
+}
+
+bool xml_converter<input_keyboard_binding>::deserialize(
+    xml_deserializer& dx,
+    input_keyboard_binding& t)
+{
+    // Bindings to a single key predate the other controls, so the control
+    // may be omitted
+    t.control = input_keyboard_control::key;
+    if (dx.node.attribute("Control") && !dx.attribute("Control", t.control)) {
+        return false;
+    }
+    switch (t.control) {
+        case input_keyboard_control::key:
+            return xml_converter<input_keyboard_key_binding>::deserialize(
+                dx,
+                t.key);
+
+        case input_keyboard_control::chord:
+            return xml_converter<input_keyboard_chord_binding>::deserialize(
+                dx,
+                t.chord);
+
+        case input_keyboard_control::sequence:
+            return
+                xml_converter<input_keyboard_sequence_binding>::deserialize(
+                    dx,
+                    t.sequence);
+    }
+}
+
 bool xml_converter<input_keyboard_binding>::serialize(
     xml_serializer& sx,
     input_keyboard_binding const& t)
+{
+    if (t.control != input_keyboard_control::key) {
+        sx.attribute("Control", t.control);
+    }
+    switch (t.control) {
+        case input_keyboard_control::key:
+            return xml_converter<input_keyboard_key_binding>::serialize(
+                sx,
+                t.key);
+
+        case input_keyboard_control::chord:
+            return xml_converter<input_keyboard_chord_binding>::serialize(
+                sx,
+                t.chord);
+
+        case input_keyboard_control::sequence:
+            return xml_converter<input_keyboard_sequence_binding>::serialize(
+                sx,
+                t.sequence);
+    }
+}
+
+bool xml_converter<input_mouse_axis_binding>::deserialize(
+    xml_deserializer& dx,
+    input_mouse_axis_binding& t)
+{
+    if (!dx.attribute("Code", t.code)) {
+        return false;
+    }
+    t.scale = input_mouse_axis_binding::default_scale;
+    dx.attribute("Scale", t.scale);
+    auto child = dx.child("Activation");
+    if (child) {
+        if (!dx.child(child.node, t.activation)) {
+            return false;
+        }
+    }
+    else {
+        t.activation.clear();
+    }
+    return true;
+}
+
+bool xml_converter<input_mouse_axis_binding>::serialize(
+    xml_serializer& sx,
+    input_mouse_axis_binding const& t)
+{
+    sx.attribute("Code", t.code);
+    if (t.scale != input_mouse_axis_binding::default_scale) {
+        sx.attribute("Scale", t.scale);
+    }
+    sx.child("Activation", t.activation);
+    return true;
+}
+
+bool xml_converter<input_mouse_button_binding>::deserialize(
+    xml_deserializer& dx,
+    input_mouse_button_binding& t)
+{
+    if (!dx.attribute("Code", t.code)) {
+        return false;
+    }
+    return true;
+}
+
+bool xml_converter<input_mouse_button_binding>::serialize(
+    xml_serializer& sx,
+    input_mouse_button_binding const& t)
+{
+    sx.attribute("Code", t.code);
+    return true;
+}
+
+bool xml_converter<input_mouse_wheel_binding>::deserialize(
+    xml_deserializer& dx,
+    input_mouse_wheel_binding& t)
+{
+    if (!dx.attribute("Code", t.code)) {
+        return false;
+    }
+    auto child = dx.child("Activation");
+    if (child) {
+        if (!dx.child(child.node, t.activation)) {
+            return false;
+        }
+    }
+    else {
+        t.activation.clear();
+    }
+    return true;
+}
+
+bool xml_converter<input_mouse_wheel_binding>::serialize(
+    xml_serializer& sx,
+    input_mouse_wheel_binding const& t)
 {
     sx.attribute("Code", t.code);
+    sx.child("Activation", t.activation);
+    return true;
+}
+
+bool xml_converter<input_mouse_binding>::deserialize(
+    xml_deserializer& dx,
+    input_mouse_binding& t)
+{
+    if (!dx.attribute("Control", t.control)) {
+        return false;
+    }
+    switch (t.control) {
+        case input_mouse_control::axis:
+            return xml_converter<input_mouse_axis_binding>::deserialize(
+                dx,
+                t.axis);
+
+        case input_mouse_control::button:
+            return xml_converter<input_mouse_button_binding>::deserialize(
+                dx,
+                t.button);
+
+        case input_mouse_control::wheel:
+            return xml_converter<input_mouse_wheel_binding>::deserialize(
+                dx,
+                t.wheel);
+    }
+}
+
+bool xml_converter<input_mouse_binding>::serialize(
+    xml_serializer& sx,
+    input_mouse_binding const& t)
+{
+    sx.attribute("Control", t.control);
+    switch (t.control) {
+        case input_mouse_control::axis:
+            return xml_converter<input_mouse_axis_binding>::serialize(
+                sx,
+                t.axis);
+
+        case input_mouse_control::button:
+            return xml_converter<input_mouse_button_binding>::serialize(
+                sx,
+                t.button);
+
+        case input_mouse_control::wheel:
+            return xml_converter<input_mouse_wheel_binding>::serialize(
+                sx,
+                t.wheel);
+    }
+}
+
+bool xml_converter<input_touch_binding>::deserialize(
+    xml_deserializer& dx,
+    input_touch_binding& t)
+{
+    if (!dx.attribute("Finger", t.finger)) {
+        return false;
+    }
+    return true;
+}
+
+bool xml_converter<input_touch_binding>::serialize(
+    xml_serializer& sx,
+    input_touch_binding const& t)
+{
+    sx.attribute("Finger", t.finger);
     return true;
 }
 
@@ -358,6 +1511,16 @@ bool xml_converter<input_binding>::deserialize(
             return xml_converter<input_keyboard_binding>::deserialize(
                 dx,
                 t.keyboard);
+
+        case input_device::mouse:
+            return xml_converter<input_mouse_binding>::deserialize(
+                dx,
+                t.mouse);
+
+        case input_device::touch:
+            return xml_converter<input_touch_binding>::deserialize(
+                dx,
+                t.touch);
     }
 }
 
@@ -376,6 +1539,16 @@ bool xml_converter<input_binding>::serialize(
             return xml_converter<input_keyboard_binding>::serialize(
                 sx,
                 t.keyboard);
+
+        case input_device::mouse:
+            return xml_converter<input_mouse_binding>::serialize(
+                sx,
+                t.mouse);
+
+        case input_device::touch:
+            return xml_converter<input_touch_binding>::serialize(
+                sx,
+                t.touch);
     }
 }
 
@@ -10,6 +10,8 @@
 #include "blip/input_activation.hpp"
 #include "blip/input_signal.hpp"
 #include "blip/xml_converter.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 
 namespace sf {
@@ -27,11 +29,22 @@ struct input_event;
 /// \addtogroup input
 /// \{
 
+/// \brief Key identifying the SFML events that a binding can map
+///
+/// A binding can only map an event with the same key, which allows the
+/// bindings for an event to be looked up rather than searched for.
+using input_dispatch_key = std::uint64_t;
+
+/// \brief Maximum number of additional dispatch keys a binding can observe
+constexpr std::size_t max_observed_dispatch_keys = 3;
+
 /// \brief Possible types of input devices
 enum class input_device
 {
     controller, //!< Game controller device
     keyboard, //!< Keyboard device
+    mouse, //!< Mouse device
+    touch, //!< Touch screen device
 };
 
 /// \brief Possible types of controller controls
@@ -41,6 +54,58 @@ enum class input_controller_control
     button, //!< Button control (button, bumper, etc.)
 };
 
+/// \brief Possible types of keyboard controls
+enum class input_keyboard_control
+{
+    key, //!< Single key
+    chord, //!< Keys held together
+    sequence, //!< Keys pressed one after another
+};
+
+/// \brief Possible types of mouse controls
+enum class input_mouse_control
+{
+    axis, //!< Movement along an axis
+    button, //!< Button control
+    wheel, //!< Wheel control
+};
+
+/// \brief Runtime state of a binding
+///
+/// Bindings describe controls and never change as they map events. The
+/// state that some of them need in order to map an event, such as the keys
+/// of a chord held so far, is kept apart from them by the
+/// \ref input_map holding them, and passed to them along with each event.
+/// A value-initialized state is that of a binding that has seen no event.
+struct input_binding_state
+{
+    /// \brief State of the analog activation of the binding
+    input_analog_activation_state activation;
+
+    /// \brief Last position of a controller axis, or of the mouse along an
+    /// axis
+    float position;
+
+    /// \brief Last position of the paired controller axis
+    float paired_position;
+
+    /// \brief Whether the mouse has moved since the state was reset
+    bool has_position;
+
+    /// \brief Bit mask of the held keys of a chord or sequence, by index in
+    /// its key list
+    unsigned held;
+
+    /// \brief Number of keys of a sequence pressed so far
+    std::size_t step;
+
+    /// \brief Time since the last key of a sequence was pressed
+    float elapsed;
+
+    /// \brief Whether a sequence is complete and its last key is held
+    bool is_down;
+};
+
 /// \brief Input binding for a controller axis
 struct input_controller_axis_binding
 {
@@ -50,16 +115,38 @@ struct input_controller_axis_binding
     /// \brief Activation parameters for the axis
     input_analog_activation activation;
 
+    /// \brief Whether the axis is paired with another, such as the other
+    /// axis of a stick, for a radial dead zone
+    bool is_paired;
+
+    /// \brief The identifying code for the paired axis
+    unsigned paired_code;
+
     /// \brief Gets the type of signal produced by this binding
     /// \return type of signal
     input_signal signal() const noexcept;
 
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets the keys of the paired axis events this binding observes
+    /// \param keys array of \ref max_observed_dispatch_keys keys to store
+    /// the paired axis key in
+    /// \return number of keys stored
+    std::size_t observed_dispatch_keys(input_dispatch_key* keys)
+        const noexcept;
+
     /// \brief Attempts to map from an SFML event to an input event through
     /// this binding
     /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
     /// \param to target input event
     /// \return whether the event was mappable through this binding
-    bool map(sf::Event const& from, input_event& to) const;
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
 };
 
 /// \brief Input binding for a controller button
@@ -72,6 +159,10 @@ struct input_controller_button_binding
     /// \return type of signal
     input_signal signal() const noexcept;
 
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
     /// \brief Attempts to map from an SFML event to an input event through
     /// this binding
     /// \param from source SFML event
@@ -100,6 +191,53 @@ struct input_controller_binding
     /// \return type of signal
     input_signal signal() const noexcept;
 
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets the keys of additional events this binding observes
+    /// \param keys array of \ref max_observed_dispatch_keys keys to store
+    /// the additional keys in
+    /// \return number of keys stored
+    std::size_t observed_dispatch_keys(input_dispatch_key* keys)
+        const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief List of keyboard key codes for a combination of keys
+struct input_key_list
+{
+    /// \brief Maximum number of keys in the list
+    static constexpr std::size_t capacity = max_observed_dispatch_keys + 1;
+
+    unsigned codes[capacity]; //!< Codes of the keys
+    std::size_t size; //!< Number of keys
+};
+
+/// \brief Input binding for a keyboard key
+struct input_keyboard_key_binding
+{
+    /// \brief The identifying code for the button
+    unsigned code;
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
     /// \brief Attempts to map from an SFML event to an input event through
     /// this binding
     /// \param from source SFML event
@@ -108,8 +246,221 @@ struct input_controller_binding
     bool map(sf::Event const& from, input_event& to) const;
 };
 
-/// \brief Input binding for a keyboard button
+/// \brief Input binding for a chord of keyboard keys
+///
+/// The binding is down while every key of the chord is held, regardless of
+/// the order in which they were pressed. The keys held are tracked as a bit
+/// mask, so no history is kept.
+struct input_keyboard_chord_binding
+{
+    /// \brief The keys of the chord
+    input_key_list keys;
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets the keys of the other keys of the chord
+    /// \param keys array of \ref max_observed_dispatch_keys keys to store
+    /// the other keys in
+    /// \return number of keys stored
+    std::size_t observed_dispatch_keys(input_dispatch_key* keys)
+        const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief Input binding for a timed sequence of keyboard keys
+///
+/// The binding goes down when the last key of the sequence is pressed, if
+/// each key was pressed within \ref interval of the one before, and goes up
+/// when that key is released. A double tap is a sequence of the same key
+/// twice. Progress through the sequence is tracked as a step and a timer
+/// advanced once per frame, so no history is kept, and is abandoned when a
+/// key outside the sequence is pressed.
+struct input_keyboard_sequence_binding
+{
+    /// \brief Default value of \ref interval, in seconds
+    static constexpr float default_interval = 0.25f;
+
+    /// \brief The keys of the sequence, in order
+    input_key_list keys;
+
+    /// \brief Maximum time between consecutive key presses, in seconds
+    float interval;
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets the keys of the other keys of the sequence
+    /// \param keys array of \ref max_observed_dispatch_keys keys to store
+    /// the other keys in
+    /// \return number of keys stored
+    std::size_t observed_dispatch_keys(input_dispatch_key* keys)
+        const noexcept;
+
+    /// \brief Advances the sequence timer, abandoning the sequence if the
+    /// next key was not pressed in time
+    /// \param time_step time elapsed in seconds
+    /// \param state state of the binding
+    void advance(float time_step, input_binding_state& state)
+        const noexcept;
+
+    /// \brief Abandons the sequence if an SFML event is a press of a key
+    /// outside it
+    /// \param from source SFML event
+    /// \param state state of the binding
+    void interrupt(sf::Event const& from, input_binding_state& state)
+        const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief Input binding for a keyboard control
 struct input_keyboard_binding
+{
+    /// \brief The type of control that is bound
+    input_keyboard_control control;
+
+    // Control bindings
+    union
+    {
+        /// \brief The key control binding
+        input_keyboard_key_binding key;
+
+        /// \brief The chord control binding
+        input_keyboard_chord_binding chord;
+
+        /// \brief The sequence control binding
+        input_keyboard_sequence_binding sequence;
+    };
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets the keys of additional events this binding observes
+    /// \param keys array of \ref max_observed_dispatch_keys keys to store
+    /// the additional keys in
+    /// \return number of keys stored
+    std::size_t observed_dispatch_keys(input_dispatch_key* keys)
+        const noexcept;
+
+    /// \brief Gets a value indicating whether the binding depends on time
+    /// \return whether \ref advance must be called every frame
+    bool is_timed() const noexcept;
+
+    /// \brief Advances the binding to a new frame
+    /// \param time_step time elapsed in seconds
+    /// \param state state of the binding
+    /// \param to target input event
+    /// \return whether the binding produced an event
+    bool advance(
+        float time_step,
+        input_binding_state& state,
+        input_event& to) const noexcept;
+
+    /// \brief Offers an SFML event to a binding that depends on events it
+    /// does not map, such as a sequence abandoned by other keys
+    /// \param from source SFML event
+    /// \param state state of the binding
+    void interrupt(sf::Event const& from, input_binding_state& state)
+        const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief Input binding for a mouse movement axis
+///
+/// The axis produces the distance moved since the previous movement, so
+/// that the mouse can stand in for a stick, and returns to rest at the
+/// start of the next frame in which the mouse does not move. The event
+/// returning it to rest is produced by advancing the bindings with a time
+/// step rather than by mapping an event.
+struct input_mouse_axis_binding
+{
+    /// \brief The identifying code for the axis; 0 for horizontal or 1 for
+    /// vertical
+    unsigned code;
+
+    /// \brief Default value of \ref scale, for which moving 100 pixels
+    /// produces a full deflection
+    static constexpr float default_scale = 0.01f;
+
+    /// \brief Factor converting the distance moved in pixels to a value
+    float scale;
+
+    /// \brief Activation parameters for the axis
+    input_analog_activation activation;
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Returns the axis to rest if it was moved
+    /// \param state state of the binding
+    /// \param to target input event
+    /// \return whether the binding produced an event
+    bool advance(input_binding_state& state, input_event& to) const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief Input binding for a mouse button
+struct input_mouse_button_binding
 {
     /// \brief The identifying code for the button
     unsigned code;
@@ -118,6 +469,113 @@ struct input_keyboard_binding
     /// \return type of signal
     input_signal signal() const noexcept;
 
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(sf::Event const& from, input_event& to) const;
+};
+
+/// \brief Input binding for a mouse wheel
+struct input_mouse_wheel_binding
+{
+    /// \brief The identifying code for the wheel
+    unsigned code;
+
+    /// \brief Activation parameters for the wheel
+    input_analog_activation activation;
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief Input binding for a mouse control
+struct input_mouse_binding
+{
+    /// \brief The type of control that is bound
+    input_mouse_control control;
+
+    // Control bindings
+    union
+    {
+        /// \brief The axis control binding
+        input_mouse_axis_binding axis;
+
+        /// \brief The button control binding
+        input_mouse_button_binding button;
+
+        /// \brief The wheel control binding
+        input_mouse_wheel_binding wheel;
+    };
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets a value indicating whether the binding depends on time
+    /// \return whether \ref advance must be called every frame
+    bool is_timed() const noexcept;
+
+    /// \brief Advances the binding to a new frame
+    /// \param state state of the binding
+    /// \param to target input event
+    /// \return whether the binding produced an event
+    bool advance(input_binding_state& state, input_event& to) const noexcept;
+
+    /// \brief Attempts to map from an SFML event to an input event through
+    /// this binding
+    /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
+    /// \param to target input event
+    /// \return whether the event was mappable through this binding
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
+};
+
+/// \brief Input binding for a touch
+///
+/// The binding is down from when the finger touches the screen until it is
+/// lifted.
+struct input_touch_binding
+{
+    /// \brief The index of the finger
+    unsigned finger;
+
+    /// \brief Gets the type of signal produced by this binding
+    /// \return type of signal
+    input_signal signal() const noexcept;
+
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
     /// \brief Attempts to map from an SFML event to an input event through
     /// this binding
     /// \param from source SFML event
@@ -140,20 +598,90 @@ struct input_binding
 
         /// \brief The keyboard device binding
         input_keyboard_binding keyboard;
+
+        /// \brief The mouse device binding
+        input_mouse_binding mouse;
+
+        /// \brief The touch device binding
+        input_touch_binding touch;
     };
 
     /// \brief Gets the type of signal produced by this binding
     /// \return type of signal
     input_signal signal() const noexcept;
 
+    /// \brief Gets the key of the events this binding can map
+    /// \return dispatch key
+    input_dispatch_key dispatch_key() const noexcept;
+
+    /// \brief Gets the keys of additional events this binding observes
+    /// \param keys array of \ref max_observed_dispatch_keys keys to store
+    /// the additional keys in
+    /// \return number of keys stored
+    std::size_t observed_dispatch_keys(input_dispatch_key* keys)
+        const noexcept;
+
+    /// \brief Gets a value indicating whether the binding depends on time
+    /// \return whether \ref advance must be called every frame
+    bool is_timed() const noexcept;
+
+    /// \brief Advances the binding to a new frame
+    /// \param time_step time elapsed in seconds
+    /// \param state state of the binding
+    /// \param to target input event
+    /// \return whether the binding produced an event
+    bool advance(
+        float time_step,
+        input_binding_state& state,
+        input_event& to) const noexcept;
+
+    /// \brief Offers an SFML event to a binding that depends on events it
+    /// does not map, such as a sequence abandoned by other keys
+    /// \param from source SFML event
+    /// \param state state of the binding
+    void interrupt(sf::Event const& from, input_binding_state& state)
+        const noexcept;
+
     /// \brief Attempts to map from an SFML event to an input event through
     /// this binding
     /// \param from source SFML event
+    /// \param state state of the binding, updated by the event
     /// \param to target input event
     /// \return whether the event was mappable through this binding
-    bool map(sf::Event const& from, input_event& to) const;
+    bool map(
+        sf::Event const& from,
+        input_binding_state& state,
+        input_event& to) const;
 };
 
+/// \brief Gets the key of the bindings that can map an SFML event
+/// \param event SFML event
+/// \param key dispatch key of \p event
+/// \return whether any binding can map \p event
+bool dispatch_key(sf::Event const& event, input_dispatch_key& key) noexcept;
+
+/// \brief Makes a binding that maps an SFML event, in order to bind the
+/// control that produced it
+/// \param from source SFML event
+/// \param signal type of signal the binding must produce
+/// \param to binding to make
+/// \return whether \p from is a deliberate use of a control that can be
+/// bound to produce \p signal
+///
+/// Key, button, and touch presses make digital bindings. Controller axes
+/// moved past \ref capture_axis_threshold and mouse wheel scrolls make
+/// analog bindings, or digital bindings activated in the direction of the
+/// movement. Releases and mouse movement are never captured. \p to is left
+/// unspecified when no binding is made.
+bool capture_binding(
+    sf::Event const& from,
+    input_signal signal,
+    input_binding& to) noexcept;
+
+/// \brief Distance a controller axis must be moved from the center to be
+/// captured by \ref capture_binding
+constexpr float capture_axis_threshold = 0.5f;
+
 /// \brief Inputs an \ref input_device from a \ref std::istream
 /// \param is stream to input from
 /// \param rhs value to input
@@ -178,6 +706,44 @@ std::istream& operator>>(std::istream& is, input_controller_control& rhs);
 /// \return \p os
 std::ostream& operator<<(std::ostream& os, input_controller_control rhs);
 
+/// \brief Inputs an \ref input_keyboard_control from a \ref std::istream
+/// \param is stream to input from
+/// \param rhs value to input
+/// \return \p is
+std::istream& operator>>(std::istream& is, input_keyboard_control& rhs);
+
+/// \brief Ouputs an \ref input_keyboard_control to a \ref std::ostream
+/// \param os stream to output to
+/// \param rhs value to output
+/// \return \p os
+std::ostream& operator<<(std::ostream& os, input_keyboard_control rhs);
+
+/// \brief Inputs an \ref input_key_list from a \ref std::istream
+/// \param is stream to input from
+/// \param rhs value to input
+/// \return \p is
+///
+/// The list is read as whitespace-separated key codes.
+std::istream& operator>>(std::istream& is, input_key_list& rhs);
+
+/// \brief Ouputs an \ref input_key_list to a \ref std::ostream
+/// \param os stream to output to
+/// \param rhs value to output
+/// \return \p os
+std::ostream& operator<<(std::ostream& os, input_key_list const& rhs);
+
+/// \brief Inputs an \ref input_mouse_control from a \ref std::istream
+/// \param is stream to input from
+/// \param rhs value to input
+/// \return \p is
+std::istream& operator>>(std::istream& is, input_mouse_control& rhs);
+
+/// \brief Ouputs an \ref input_mouse_control to a \ref std::ostream
+/// \param os stream to output to
+/// \param rhs value to output
+/// \return \p os
+std::ostream& operator<<(std::ostream& os, input_mouse_control rhs);
+
 /// \}
 
 /// \addtogroup xml
@@ -255,6 +821,78 @@ struct xml_converter<input_controller_binding>
         input_controller_binding const& t);
 };
 
+/// \brief Specifies XML conversion functions for
+/// \ref input_keyboard_key_binding
+template <>
+struct xml_converter<input_keyboard_key_binding>
+{
+    /// \brief Deserializes a \ref input_keyboard_key_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_keyboard_key_binding& t);
+
+    /// \brief Serializes a \ref input_keyboard_key_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_keyboard_key_binding const& t);
+};
+
+/// \brief Specifies XML conversion functions for
+/// \ref input_keyboard_chord_binding
+template <>
+struct xml_converter<input_keyboard_chord_binding>
+{
+    /// \brief Deserializes a \ref input_keyboard_chord_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_keyboard_chord_binding& t);
+
+    /// \brief Serializes a \ref input_keyboard_chord_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_keyboard_chord_binding const& t);
+};
+
+/// \brief Specifies XML conversion functions for
+/// \ref input_keyboard_sequence_binding
+template <>
+struct xml_converter<input_keyboard_sequence_binding>
+{
+    /// \brief Deserializes a \ref input_keyboard_sequence_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_keyboard_sequence_binding& t);
+
+    /// \brief Serializes a \ref input_keyboard_sequence_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_keyboard_sequence_binding const& t);
+};
+
 /// \brief Specifies XML conversion functions for
 /// \ref input_keyboard_binding
 template <>
@@ -279,6 +917,126 @@ struct xml_converter<input_keyboard_binding>
         input_keyboard_binding const& t);
 };
 
+/// \brief Specifies XML conversion functions for
+/// \ref input_mouse_axis_binding
+template <>
+struct xml_converter<input_mouse_axis_binding>
+{
+    /// \brief Deserializes a \ref input_mouse_axis_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_mouse_axis_binding& t);
+
+    /// \brief Serializes a \ref input_mouse_axis_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_mouse_axis_binding const& t);
+};
+
+/// \brief Specifies XML conversion functions for
+/// \ref input_mouse_button_binding
+template <>
+struct xml_converter<input_mouse_button_binding>
+{
+    /// \brief Deserializes a \ref input_mouse_button_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_mouse_button_binding& t);
+
+    /// \brief Serializes a \ref input_mouse_button_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_mouse_button_binding const& t);
+};
+
+/// \brief Specifies XML conversion functions for
+/// \ref input_mouse_wheel_binding
+template <>
+struct xml_converter<input_mouse_wheel_binding>
+{
+    /// \brief Deserializes a \ref input_mouse_wheel_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_mouse_wheel_binding& t);
+
+    /// \brief Serializes a \ref input_mouse_wheel_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_mouse_wheel_binding const& t);
+};
+
+/// \brief Specifies XML conversion functions for
+/// \ref input_mouse_binding
+template <>
+struct xml_converter<input_mouse_binding>
+{
+    /// \brief Deserializes a \ref input_mouse_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_mouse_binding& t);
+
+    /// \brief Serializes a \ref input_mouse_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_mouse_binding const& t);
+};
+
+/// \brief Specifies XML conversion functions for
+/// \ref input_touch_binding
+template <>
+struct xml_converter<input_touch_binding>
+{
+    /// \brief Deserializes a \ref input_touch_binding from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t binding to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(
+        xml_deserializer& dx,
+        input_touch_binding& t);
+
+    /// \brief Serializes a \ref input_touch_binding to a
+    /// \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t binding to output
+    /// \return whether the serialization was successful
+    static bool serialize(
+        xml_serializer& sx,
+        input_touch_binding const& t);
+};
+
 /// \brief Specifies XML conversion functions for \ref input_binding
 template <>
 struct xml_converter<input_binding>
@@ -0,0 +1,194 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::input_dispatch_table class implementation
+/// \ingroup input
+
+#include "blip/input_dispatch_table.hpp"
+#include "blip/input_binding_context.hpp"
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace {
+
+/// \brief Orders entries by context and then by binding
+/// \param lhs left-hand entry
+/// \param rhs right-hand entry
+/// \return whether \p lhs is ordered before \p rhs
+bool entry_less(
+    blip::input_dispatch_table::entry lhs,
+    blip::input_dispatch_table::entry rhs) noexcept
+{
+    return std::tie(lhs.context, lhs.binding)
+        < std::tie(rhs.context, rhs.binding);
+}
+
+}
+
+namespace blip {
+
+void input_dispatch_table::rebuild(
+    std::vector<input_binding_context> const& contexts)
+{
+    clear();
+
+    for (std::size_t c = 0; c < contexts.size(); ++c) {
+        append(contexts, c);
+        auto& bindings = contexts[c].bindings;
+        for (std::size_t b = 0; b < bindings.size(); ++b) {
+            if (bindings[b].is_timed()) {
+                _timed.push_back({static_cast<std::uint32_t>(c),
+                    static_cast<std::uint32_t>(b)});
+            }
+        }
+    }
+
+    // A stable sort keeps the entries for each key in map order, so that
+    // lookups produce events in the same order as a scan of the contexts
+    std::stable_sort(std::begin(_keyed), std::end(_keyed),
+        [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+
+    _entries.reserve(_keyed.size());
+    _keys.reserve(_keyed.size());
+    for (auto&& keyed : _keyed) {
+        _keys.emplace_back(keyed.first);
+        _entries.emplace_back(keyed.second);
+    }
+    rebuild_ranges();
+    _context_count = contexts.size();
+}
+
+void input_dispatch_table::update(
+    std::vector<input_binding_context> const& contexts,
+    std::size_t context)
+{
+    auto is_appended = context == _context_count
+        && contexts.size() == _context_count + 1;
+    if (!is_appended && contexts.size() != _context_count) {
+        rebuild(contexts);
+        return;
+    }
+
+    _keyed.clear();
+    append(contexts, context);
+    std::stable_sort(std::begin(_keyed), std::end(_keyed),
+        [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+
+    // Drop the old entries of the context and merge in the new ones in a
+    // single pass, as both lists are already in order
+    auto index = static_cast<std::uint32_t>(context);
+    std::size_t kept{0};
+    for (std::size_t i = 0; i < _entries.size(); ++i) {
+        if (_entries[i].context != index) {
+            _keys[kept] = _keys[i];
+            _entries[kept] = _entries[i];
+            ++kept;
+        }
+    }
+    auto merged = kept + _keyed.size();
+    _keys.resize(merged);
+    _entries.resize(merged);
+    auto from = kept;
+    auto added = _keyed.size();
+    for (auto to = merged; to-- > 0;) {
+        auto take_added = added > 0 && (from == 0
+            || _keys[from - 1] < _keyed[added - 1].first
+            || (_keys[from - 1] == _keyed[added - 1].first
+                && entry_less(_entries[from - 1], _keyed[added - 1].second)));
+        if (take_added) {
+            --added;
+            _keys[to] = _keyed[added].first;
+            _entries[to] = _keyed[added].second;
+        }
+        else {
+            --from;
+            _keys[to] = _keys[from];
+            _entries[to] = _entries[from];
+        }
+    }
+    rebuild_ranges();
+
+    _timed.erase(
+        std::remove_if(std::begin(_timed), std::end(_timed),
+            [index](entry e) { return e.context == index; }),
+        std::end(_timed));
+    auto& bindings = contexts[context].bindings;
+    auto pos = std::lower_bound(std::begin(_timed), std::end(_timed),
+        entry{index, 0}, entry_less);
+    for (std::size_t b = 0; b < bindings.size(); ++b) {
+        if (bindings[b].is_timed()) {
+            pos = _timed.insert(pos,
+                entry{index, static_cast<std::uint32_t>(b)}) + 1;
+        }
+    }
+    _context_count = contexts.size();
+}
+
+void input_dispatch_table::clear() noexcept
+{
+    _entries.clear();
+    _keys.clear();
+    _keyed.clear();
+    _ranges.clear();
+    _timed.clear();
+    _context_count = 0;
+}
+
+auto input_dispatch_table::equal_range(input_dispatch_key key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    auto iter = _ranges.find(key);
+    if (iter == std::end(_ranges)) {
+        return {std::end(_entries), std::end(_entries)};
+    }
+    auto first = std::begin(_entries);
+    return {
+        first + static_cast<std::ptrdiff_t>(iter->second.first),
+        first + static_cast<std::ptrdiff_t>(iter->second.second)};
+}
+
+void input_dispatch_table::append(
+    std::vector<input_binding_context> const& contexts,
+    std::size_t context)
+{
+    auto& bindings = contexts[context].bindings;
+    for (std::size_t b = 0; b < bindings.size(); ++b) {
+        entry e{static_cast<std::uint32_t>(context),
+            static_cast<std::uint32_t>(b)};
+        _keyed.push_back({bindings[b].dispatch_key(), e});
+
+        // Bindings observing other controls, such as an axis paired for a
+        // radial dead zone or the keys of a chord, are also found through
+        // their keys
+        input_dispatch_key observed[max_observed_dispatch_keys];
+        auto count = bindings[b].observed_dispatch_keys(observed);
+        for (std::size_t i = 0; i < count; ++i) {
+            _keyed.push_back({observed[i], e});
+        }
+    }
+}
+
+void input_dispatch_table::rebuild_ranges()
+{
+    // Keys whose entries were all removed must not keep a stale range
+    for (auto iter = std::begin(_ranges); iter != std::end(_ranges);) {
+        if (!std::binary_search(std::begin(_keys), std::end(_keys),
+            iter->first))
+        {
+            iter = _ranges.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+    for (std::size_t i = 0; i < _keys.size(); ++i) {
+        if (i == 0 || _keys[i] != _keys[i - 1]) {
+            _ranges[_keys[i]] = std::make_pair(i, i);
+        }
+        ++_ranges[_keys[i]].second;
+    }
+}
+
+}
@@ -0,0 +1,111 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::input_dispatch_table class interface
+/// \ingroup input
+
+#pragma once
+
+#include "blip/input_binding.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace blip {
+
+// Forward declarations
+struct input_binding_context;
+
+/// \addtogroup input
+/// \{
+
+/// \brief Index of the bindings in a list of binding contexts by the events
+/// they can map
+///
+/// Entries refer to bindings by position, so the table remains valid when
+/// the contexts are copied or moved, but must be rebuilt whenever bindings
+/// or contexts are added, removed, or reordered. Changes to the bindings of
+/// a single context, or a context appended to the end of the list, can be
+/// applied with \ref update instead, which leaves the entries of the other
+/// contexts in place.
+class input_dispatch_table
+{
+public:
+    /// \brief Position of a binding within a list of binding contexts
+    struct entry
+    {
+        std::uint32_t context; //!< Index of the binding context
+        std::uint32_t binding; //!< Index of the binding within its context
+    };
+
+    /// \brief Type of iterator over entries
+    using const_iterator = std::vector<entry>::const_iterator;
+
+    /// \brief Gets the number of contexts the table was built from
+    /// \return number of contexts
+    std::size_t context_count() const noexcept { return _context_count; }
+
+    /// \brief Rebuilds the table from a list of binding contexts
+    /// \param contexts contexts to index
+    void rebuild(std::vector<input_binding_context> const& contexts);
+
+    /// \brief Updates the entries of a single context
+    /// \param contexts contexts the table was built from
+    /// \param context index of the context whose bindings changed, or of a
+    /// context appended since the table was built
+    ///
+    /// Falls back to \ref rebuild if any other context was added or removed.
+    void update(
+        std::vector<input_binding_context> const& contexts,
+        std::size_t context);
+
+    /// \brief Removes every entry from the table
+    void clear() noexcept;
+
+    /// \brief Gets the bindings that must be advanced every frame
+    /// \return list of entries, ordered by context and then by binding
+    std::vector<entry> const& timed() const noexcept { return _timed; }
+
+    /// \brief Finds the bindings that can map events with the given key
+    /// \param key dispatch key
+    /// \return range of entries, ordered by context and then by binding
+    std::pair<const_iterator, const_iterator> equal_range(
+        input_dispatch_key key) const;
+
+private:
+    /// \brief Appends the keyed entries of a context
+    /// \param contexts contexts to index
+    /// \param context index of the context
+    void append(
+        std::vector<input_binding_context> const& contexts,
+        std::size_t context);
+
+    /// \brief Rebuilds \ref _ranges from \ref _keys
+    void rebuild_ranges();
+
+    /// \brief Entries grouped by dispatch key, and then ordered by context
+    /// and by binding
+    std::vector<entry> _entries;
+
+    /// \brief Dispatch key of each entry in \ref _entries
+    std::vector<input_dispatch_key> _keys;
+
+    /// \brief Keyed entries of the contexts being indexed
+    std::vector<std::pair<input_dispatch_key, entry>> _keyed;
+
+    /// \brief Range of \ref _entries for each dispatch key
+    std::unordered_map<input_dispatch_key, std::pair<std::size_t, std::size_t>>
+        _ranges;
+
+    /// \brief Entries of the bindings that must be advanced every frame
+    std::vector<entry> _timed;
+
+    std::size_t _context_count{0}; //!< Number of contexts indexed
+};
+
+/// \}
+
+}
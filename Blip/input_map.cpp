@@ -54,6 +54,7 @@ bool input_map::erase(
         return false;
     }
     contexts.erase(iter);
+    rebuild();
     return true;
 }
 
@@ -62,10 +63,25 @@ auto input_map::find(
     input_action const* action) const
     -> decltype(contexts)::const_iterator
 {
+    if (_indexed_count != contexts.size()) {
+        reindex();
+    }
     auto first = std::begin(contexts);
     auto last = std::end(contexts);
     auto pred = [action_context, action](auto& i)
     { return i.action_context == action_context && i.action == action; };
+    if (action != nullptr) {
+        auto iter = _index.find(action->id);
+        if (iter != std::end(_index) && iter->second < contexts.size()) {
+            auto pos = first + static_cast<std::ptrdiff_t>(iter->second);
+            if (pred(*pos)) {
+                return pos;
+            }
+        }
+    }
+
+    // Actions without assigned IDs share an index entry, so fall back to a
+    // search when the indexed context does not match
     return std::find_if(first, last, pred);
 }
 
@@ -74,52 +90,410 @@ auto input_map::find(
     input_action const* action)
     -> decltype(contexts)::iterator
 {
-    auto first = std::begin(contexts);
-    auto last = std::end(contexts);
-    auto pred = [action_context, action](auto& i)
-    { return i.action_context == action_context && i.action == action; };
-    return std::find_if(first, last, pred);
+    auto iter = static_cast<input_map const&>(*this).find(
+        action_context, action);
+    return std::begin(contexts) + (iter - std::cbegin(contexts));
 }
 
-std::vector<input_event> input_map::map(sf::Event const& from) const
+void input_map::reindex() const
 {
-    std::vector<input_event> tos;
-    for (auto&& context : contexts) {
-        for (auto&& binding : context.bindings) {
-            input_event to;
-            if (binding.map(from, to)) {
-                to.context = context.action_context;
-                to.action = context.action;
-                to.binding = &binding;
-                tos.emplace_back(std::move(to));
-            }
+    _index.clear();
+    for (std::size_t i = 0; i < contexts.size(); ++i) {
+        if (contexts[i].action != nullptr) {
+            _index.emplace(contexts[i].action->id, i);
         }
     }
-    return tos;
+    _indexed_count = contexts.size();
 }
 
-std::vector<input_event> input_map::map(
-    sf::Event const& from,
-    input_action_context const* action_context) const
+void input_map::rebuild()
 {
-    std::vector<input_event> tos;
-    for (auto&& context : contexts) {
-        if (context.action_context != action_context) {
+    _dispatch.rebuild(contexts);
+    reset_states();
+    reindex();
+}
+
+void input_map::synchronize()
+{
+    // Contexts added or removed since the last rebuild would leave the table
+    // and the states pointing at the wrong bindings
+    if (_dispatch.context_count() != contexts.size()) {
+        _dispatch.rebuild(contexts);
+        reset_states();
+    }
+}
+
+void input_map::reset_states()
+{
+    _states.resize(contexts.size());
+    for (std::size_t i = 0; i < contexts.size(); ++i) {
+        _states[i].assign(contexts[i].bindings.size(), input_binding_state{});
+    }
+}
+
+template <typename Output>
+std::size_t input_map::advance(float time_step, Output output)
+{
+    synchronize();
+
+    // A binding whose event is dropped is still advanced, so that its state
+    // does not depend on the capacity of the caller's buffer
+    std::size_t count{0};
+    auto is_full = false;
+    for (auto&& entry : _dispatch.timed()) {
+        auto& context = contexts[entry.context];
+        auto& states = _states[entry.context];
+        if (entry.binding >= context.bindings.size()
+            || entry.binding >= states.size())
+        {
             continue;
         }
-        for (auto&& binding : context.bindings) {
-            input_event to;
-            if (binding.map(from, to)) {
-                to.context = context.action_context;
-                to.action = context.action;
-                to.binding = &binding;
-                tos.emplace_back(std::move(to));
+        auto& binding = context.bindings[entry.binding];
+        input_event to;
+        if (binding.advance(time_step, states[entry.binding], to)
+            && !is_full)
+        {
+            to.context = context.action_context;
+            to.action = context.action;
+            to.binding = &binding;
+            ++count;
+            is_full = !output(to);
+        }
+    }
+    return count;
+}
+
+std::size_t input_map::update(
+    float time_step,
+    std::vector<input_event>& tos)
+{
+    return advance(time_step,
+        [&tos](input_event const& to)
+        {
+            tos.emplace_back(to);
+            return true;
+        });
+}
+
+std::size_t input_map::update(
+    float time_step,
+    input_event* tos,
+    std::size_t capacity)
+{
+    std::size_t n{0};
+    advance(time_step,
+        [tos, capacity, &n](input_event const& to)
+        {
+            if (n < capacity) {
+                tos[n++] = to;
             }
+            return n < capacity;
+        });
+    return n;
+}
+
+void input_map::update(sf::Event const& from)
+{
+    _mapped.clear();
+    synchronize();
+
+    // Sequences in progress are abandoned by keys they are not dispatched
+    if (from.type == sf::Event::KeyPressed) {
+        for (auto&& entry : _dispatch.timed()) {
+            auto& context = contexts[entry.context];
+            auto& states = _states[entry.context];
+            if (entry.binding < context.bindings.size()
+                && entry.binding < states.size()
+                && states[entry.binding].step != 0)
+            {
+                context.bindings[entry.binding].interrupt(from,
+                    states[entry.binding]);
+            }
+        }
+    }
+
+    input_dispatch_key key;
+    if (!dispatch_key(from, key)) {
+        return;
+    }
+    auto range = _dispatch.equal_range(key);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        auto& context = contexts[iter->context];
+        auto& states = _states[iter->context];
+        if (iter->binding >= context.bindings.size()
+            || iter->binding >= states.size())
+        {
+            continue;
+        }
+        auto& binding = context.bindings[iter->binding];
+        input_event to;
+        if (binding.map(from, states[iter->binding], to)) {
+            to.context = context.action_context;
+            to.action = context.action;
+            to.binding = &binding;
+            _mapped.emplace_back(to);
+        }
+    }
+}
+
+void input_map::bind(
+    input_action_context const* action_context,
+    input_action const* action,
+    input_binding const& binding)
+{
+    auto position = position_of(action_context, action);
+    contexts[position].bindings.emplace_back(binding);
+    changed(position);
+}
+
+void input_map::rebind(
+    input_action_context const* action_context,
+    input_action const* action,
+    std::size_t index,
+    input_binding const& binding)
+{
+    auto position = position_of(action_context, action);
+    auto& bindings = contexts[position].bindings;
+    if (index > bindings.size()) {
+        throw std::out_of_range{"binding index out of range"};
+    }
+    if (index == bindings.size()) {
+        bindings.emplace_back(binding);
+    }
+    else {
+        bindings[index] = binding;
+    }
+    changed(position);
+}
+
+bool input_map::unbind(
+    input_action_context const* action_context,
+    input_action const* action,
+    std::size_t index)
+{
+    auto iter = find(action_context, action);
+    if (iter == std::end(contexts) || index >= iter->bindings.size()) {
+        return false;
+    }
+    auto& bindings = iter->bindings;
+    bindings.erase(std::begin(bindings)
+        + static_cast<std::ptrdiff_t>(index));
+    changed(static_cast<std::size_t>(iter - std::begin(contexts)));
+    return true;
+}
+
+std::size_t input_map::unbind(
+    input_action_context const* action_context,
+    input_action const* action)
+{
+    auto iter = find(action_context, action);
+    if (iter == std::end(contexts) || iter->bindings.empty()) {
+        return 0;
+    }
+    auto count = iter->bindings.size();
+    iter->bindings.clear();
+    changed(static_cast<std::size_t>(iter - std::begin(contexts)));
+    return count;
+}
+
+void input_map::begin_capture(
+    input_action_context const* action_context,
+    input_action const* action,
+    std::size_t index)
+{
+    if (action == nullptr) {
+        throw std::invalid_argument{"action must not be null"};
+    }
+    _capture_context = action_context;
+    _capture_action = action;
+    _capture_index = index;
+}
+
+void input_map::cancel_capture() noexcept
+{
+    _capture_context = nullptr;
+    _capture_action = nullptr;
+    _capture_index = 0;
+}
+
+bool input_map::capture(sf::Event const& from)
+{
+    if (!is_capturing()) {
+        return false;
+    }
+    input_binding binding;
+    if (!capture_binding(from, _capture_action->signal, binding)) {
+        return false;
+    }
+
+    // The capture ends before rebinding so that it does not remain active
+    // if the index has become invalid in the meantime
+    auto action_context = _capture_context;
+    auto action = _capture_action;
+    auto index = _capture_index;
+    cancel_capture();
+    auto position = position_of(action_context, action);
+    rebind(action_context, action,
+        std::min(index, contexts[position].bindings.size()), binding);
+    return true;
+}
+
+std::size_t input_map::position_of(
+    input_action_context const* action_context,
+    input_action const* action)
+{
+    auto iter = find(action_context, action);
+    if (iter != std::end(contexts)) {
+        return static_cast<std::size_t>(iter - std::begin(contexts));
+    }
+    contexts.push_back({action_context, action, {}});
+    return contexts.size() - 1;
+}
+
+void input_map::changed(std::size_t position)
+{
+    _dispatch.update(contexts, position);
+
+    // The state of the other contexts is kept unless they were moved
+    if (_states.size() + 1 == contexts.size()
+        && position == _states.size())
+    {
+        _states.emplace_back(contexts[position].bindings.size(),
+            input_binding_state{});
+    }
+    else if (_states.size() == contexts.size()) {
+        _states[position].assign(contexts[position].bindings.size(),
+            input_binding_state{});
+    }
+    else {
+        reset_states();
+    }
+
+    // Only an appended context changes the index, and then only by a single
+    // entry
+    if (_indexed_count + 1 == contexts.size()
+        && position == _indexed_count)
+    {
+        if (contexts[position].action != nullptr) {
+            _index.emplace(contexts[position].action->id, position);
         }
+        ++_indexed_count;
     }
+    else if (_indexed_count != contexts.size()) {
+        reindex();
+    }
+    _is_dirty = true;
+}
+
+template <typename Filter, typename Output>
+std::size_t input_map::select(Filter filter, Output output) const
+{
+    std::size_t count{0};
+    for (auto&& to : _mapped) {
+        if (!filter(to)) {
+            continue;
+        }
+        ++count;
+        if (!output(to)) {
+            break;
+        }
+    }
+    return count;
+}
+
+std::size_t input_map::mapped(
+    input_action_context const* action_context,
+    std::vector<input_event>& tos) const
+{
+    return select(
+        [action_context](input_event const& to)
+        { return to.context == action_context; },
+        [&tos](input_event const& to)
+        {
+            tos.emplace_back(to);
+            return true;
+        });
+}
+
+std::vector<input_event> input_map::map(sf::Event const& from)
+{
+    std::vector<input_event> tos;
+    map(from, tos);
     return tos;
 }
 
+std::size_t input_map::map(
+    sf::Event const& from,
+    std::vector<input_event>& tos)
+{
+    update(from);
+    return select(
+        [](input_event const&) { return true; },
+        [&tos](input_event const& to)
+        {
+            tos.emplace_back(to);
+            return true;
+        });
+}
+
+std::size_t input_map::map(
+    sf::Event const& from,
+    input_event* tos,
+    std::size_t capacity)
+{
+    update(from);
+    std::size_t n{0};
+    select(
+        [](input_event const&) { return true; },
+        [tos, capacity, &n](input_event const& to)
+        {
+            if (n < capacity) {
+                tos[n++] = to;
+            }
+            return n < capacity;
+        });
+    return n;
+}
+
+std::vector<input_event> input_map::map(
+    sf::Event const& from,
+    input_action_context const* action_context)
+{
+    std::vector<input_event> tos;
+    map(from, action_context, tos);
+    return tos;
+}
+
+std::size_t input_map::map(
+    sf::Event const& from,
+    input_action_context const* action_context,
+    std::vector<input_event>& tos)
+{
+    update(from);
+    return mapped(action_context, tos);
+}
+
+std::size_t input_map::map(
+    sf::Event const& from,
+    input_action_context const* action_context,
+    input_event* tos,
+    std::size_t capacity)
+{
+    update(from);
+    std::size_t n{0};
+    select(
+        [action_context](input_event const& to)
+        { return to.context == action_context; },
+        [tos, capacity, &n](input_event const& to)
+        {
+            if (n < capacity) {
+                tos[n++] = to;
+            }
+            return n < capacity;
+        });
+    return n;
+}
+
 bool xml_converter<input_map>::deserialize(
     xml_deserializer& dx,
     input_map& t,
@@ -132,6 +506,7 @@ bool xml_converter<input_map>::deserialize(
         }
         t.contexts.emplace_back(std::move(context));
     }
+    t.rebuild();
     return true;
 }
 
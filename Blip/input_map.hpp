@@ -8,17 +8,15 @@
 #pragma once
 
 #include "blip/input_binding_context.hpp"
+#include "blip/input_dispatch_table.hpp"
+#include "blip/fixed_vector.hpp"
 #include "blip/input_event.hpp"
 #include "blip/xml_converter.hpp"
+#include <SFML/Window/Event.hpp>
+#include <cstddef>
+#include <unordered_map>
 #include <vector>
 
-namespace sf {
-
-// Forward declarations
-class Event;
-
-}
-
 namespace blip {
 
 // Forward declarations
@@ -30,6 +28,29 @@ struct input_specification;
 /// \{
 
 /// \brief User-defined mapping between actions and bindings
+///
+/// Events are mapped through a dispatch table indexing the bindings by the
+/// events they can map. The table is rebuilt automatically when contexts are
+/// added or removed, but \ref rebuild must be called after bindings are
+/// modified within an existing context.
+///
+/// Contexts are found through an index keyed by the action ID, which is
+/// maintained alongside the dispatch table.
+///
+/// Bindings can be changed at run time through \ref rebind, \ref unbind,
+/// and \ref begin_capture, which update the dispatch table and the index
+/// for the affected context only and mark the map as dirty so that it can
+/// be saved.
+///
+/// The runtime state of the bindings, such as the keys of a chord held so
+/// far, is kept by the map alongside the contexts rather than in the
+/// bindings. Passing an event to \ref update advances the state of every
+/// binding that can map it exactly once, whichever contexts or buffer
+/// capacity it is mapped with, and keeps the events it produces. They can
+/// then be read any number of times through \ref mapped without advancing
+/// the bindings again. \ref map updates and reads in one call, so an event
+/// must be mapped only once. The state of a context is reset when its
+/// bindings change.
 struct input_map
 {
     /// \brief List of member binding contexts
@@ -87,10 +108,213 @@ struct input_map
         input_action const* action)
         -> decltype(contexts)::iterator;
 
+    /// \brief Rebuilds the dispatch table and action index from the contexts
+    void rebuild();
+
+    /// \brief Appends a binding to an action
+    /// \param action_context action context of the binding context
+    /// \param action action of the binding context
+    /// \param binding binding to append
+    ///
+    /// The binding context is created if the map does not contain one for
+    /// the action.
+    void bind(
+        input_action_context const* action_context,
+        input_action const* action,
+        input_binding const& binding);
+
+    /// \brief Replaces a binding of an action
+    /// \param action_context action context of the binding context
+    /// \param action action of the binding context
+    /// \param index index of the binding within its context, or the number
+    /// of bindings in the context to append the binding
+    /// \param binding new binding
+    ///
+    /// Throws \ref std::out_of_range if \p index is greater than the number
+    /// of bindings in the context.
+    void rebind(
+        input_action_context const* action_context,
+        input_action const* action,
+        std::size_t index,
+        input_binding const& binding);
+
+    /// \brief Removes a binding from an action
+    /// \param action_context action context of the binding context
+    /// \param action action of the binding context
+    /// \param index index of the binding within its context
+    /// \return whether the binding was removed
+    bool unbind(
+        input_action_context const* action_context,
+        input_action const* action,
+        std::size_t index);
+
+    /// \brief Removes every binding from an action
+    /// \param action_context action context of the binding context
+    /// \param action action of the binding context
+    /// \return number of bindings removed
+    ///
+    /// The binding context is kept, without bindings, so that the action
+    /// remains unbound when the map is saved and loaded again.
+    std::size_t unbind(
+        input_action_context const* action_context,
+        input_action const* action);
+
+    /// \brief Begins capturing the next input as a binding for an action
+    /// \param action_context action context of the binding context
+    /// \param action action of the binding context
+    /// \param index index of the binding to replace, or the number of
+    /// bindings in the context to append the binding
+    ///
+    /// The binding is made from the next event passed to \ref capture that
+    /// can produce the signal of \p action. Throws
+    /// \ref std::invalid_argument if \p action is null.
+    void begin_capture(
+        input_action_context const* action_context,
+        input_action const* action,
+        std::size_t index);
+
+    /// \brief Stops capturing input without changing any binding
+    void cancel_capture() noexcept;
+
+    /// \brief Gets a value indicating whether input is being captured
+    /// \return whether input is being captured
+    bool is_capturing() const noexcept { return _capture_action != nullptr; }
+
+    /// \brief Offers an SFML event to a capture in progress
+    /// \param from source SFML event
+    /// \return whether the event was captured as a binding, in which case
+    /// it should not be processed further
+    bool capture(sf::Event const& from);
+
+    /// \brief Gets a value indicating whether the bindings have changed
+    /// since the map was loaded or last saved
+    /// \return whether the map is dirty
+    bool is_dirty() const noexcept { return _is_dirty; }
+
+    /// \brief Sets a value indicating whether the bindings have changed
+    /// since the map was loaded or last saved
+    /// \param is_dirty whether the map is dirty
+    void is_dirty(bool is_dirty) noexcept { _is_dirty = is_dirty; }
+
+    /// \brief Advances the bindings that depend on time to a new frame,
+    /// such as key sequences and mouse axes
+    /// \param time_step time elapsed in seconds
+    /// \param tos list to append produced input events to
+    /// \return number of events appended to \p tos
+    ///
+    /// Must be called once per frame, before the events of the frame are
+    /// mapped.
+    std::size_t update(float time_step, std::vector<input_event>& tos);
+
+    /// \brief Advances the bindings that depend on time to a new frame,
+    /// such as key sequences and mouse axes
+    /// \param time_step time elapsed in seconds
+    /// \param tos buffer to write produced input events to
+    /// \param capacity number of events \p tos can hold
+    /// \return number of events written to \p tos
+    ///
+    /// Never allocates. Every binding is advanced, but events beyond
+    /// \p capacity are dropped.
+    std::size_t update(
+        float time_step,
+        input_event* tos,
+        std::size_t capacity);
+
+    /// \brief Advances the bindings that depend on time to a new frame,
+    /// such as key sequences and mouse axes
+    /// \tparam N capacity of the buffer
+    /// \param time_step time elapsed in seconds
+    /// \param tos buffer to append produced input events to
+    /// \return number of events appended to \p tos
+    ///
+    /// Never allocates. Every binding is advanced, but events beyond the
+    /// capacity of \p tos are dropped.
+    template <std::size_t N>
+    std::size_t update(
+        float time_step,
+        fixed_vector<input_event, N>& tos)
+    {
+        auto count = update(time_step, tos.end(),
+            tos.capacity() - tos.size());
+        tos.resize(tos.size() + count);
+        return count;
+    }
+
+    /// \brief Advances the state of the bindings through an SFML event
+    /// \param from source SFML event
+    ///
+    /// Every binding that can map the event sees it once, in every context.
+    /// The events it produces are kept, for \ref mapped, until the next
+    /// event is passed.
+    void update(sf::Event const& from);
+
+    /// \brief Gets the input events mapped from the last event passed to
+    /// \ref update or \ref map
+    /// \return list of mapped input events
+    ///
+    /// Does not advance the bindings, so it can be read any number of
+    /// times.
+    std::vector<input_event> const& mapped() const noexcept
+    {
+        return _mapped;
+    }
+
+    /// \brief Gets the input events mapped from the last event passed to
+    /// \ref update or \ref map for the given action context
+    /// \param action_context action context to get events for
+    /// \param tos list to append the mapped input events to
+    /// \return number of events appended to \p tos
+    ///
+    /// Does not advance the bindings.
+    std::size_t mapped(
+        input_action_context const* action_context,
+        std::vector<input_event>& tos) const;
+
     /// \brief Attempts to map an SFML event using the bindings in the map
     /// \param from source SFML event
     /// \return list of mapped input events
-    std::vector<input_event> map(sf::Event const& from) const;
+    ///
+    /// Advances the bindings through the event as \ref update does, so the
+    /// same event must not be mapped again; read \ref mapped instead.
+    std::vector<input_event> map(sf::Event const& from);
+
+    /// \brief Attempts to map an SFML event using the bindings in the map
+    /// \param from source SFML event
+    /// \param tos list to append mapped input events to
+    /// \return number of events appended to \p tos
+    ///
+    /// Does not allocate unless \p tos must grow, so a list reused across
+    /// events reaches a steady state without allocating.
+    std::size_t map(sf::Event const& from, std::vector<input_event>& tos);
+
+    /// \brief Attempts to map an SFML event using the bindings in the map
+    /// \param from source SFML event
+    /// \param tos buffer to write mapped input events to
+    /// \param capacity number of events \p tos can hold
+    /// \return number of events written to \p tos
+    ///
+    /// Never allocates. Events beyond \p capacity are dropped.
+    std::size_t map(
+        sf::Event const& from,
+        input_event* tos,
+        std::size_t capacity);
+
+    /// \brief Attempts to map an SFML event using the bindings in the map
+    /// \tparam N capacity of the buffer
+    /// \param from source SFML event
+    /// \param tos buffer to append mapped input events to
+    /// \return number of events appended to \p tos
+    ///
+    /// Never allocates. Events beyond the capacity of \p tos are dropped.
+    template <std::size_t N>
+    std::size_t map(
+        sf::Event const& from,
+        fixed_vector<input_event, N>& tos)
+    {
+        auto count = map(from, tos.end(), tos.capacity() - tos.size());
+        tos.resize(tos.size() + count);
+        return count;
+    }
 
     /// \brief Attempts to map an SFML event using the bindings in the map
     /// for the given action context
@@ -99,7 +323,126 @@ struct input_map
     /// \return list of mapped input events
     std::vector<input_event> map(
         sf::Event const& from,
-        input_action_context const* action_context) const;
+        input_action_context const* action_context);
+
+    /// \brief Attempts to map an SFML event using the bindings in the map
+    /// for the given action context
+    /// \param from source SFML event
+    /// \param action_context action context to map for
+    /// \param tos list to append mapped input events to
+    /// \return number of events appended to \p tos
+    std::size_t map(
+        sf::Event const& from,
+        input_action_context const* action_context,
+        std::vector<input_event>& tos);
+
+    /// \brief Attempts to map an SFML event using the bindings in the map
+    /// for the given action context
+    /// \param from source SFML event
+    /// \param action_context action context to map for
+    /// \param tos buffer to write mapped input events to
+    /// \param capacity number of events \p tos can hold
+    /// \return number of events written to \p tos
+    ///
+    /// Never allocates. Events beyond \p capacity are dropped.
+    std::size_t map(
+        sf::Event const& from,
+        input_action_context const* action_context,
+        input_event* tos,
+        std::size_t capacity);
+
+    /// \brief Attempts to map an SFML event using the bindings in the map
+    /// for the given action context
+    /// \tparam N capacity of the buffer
+    /// \param from source SFML event
+    /// \param action_context action context to map for
+    /// \param tos buffer to append mapped input events to
+    /// \return number of events appended to \p tos
+    ///
+    /// Never allocates. Events beyond the capacity of \p tos are dropped.
+    template <std::size_t N>
+    std::size_t map(
+        sf::Event const& from,
+        input_action_context const* action_context,
+        fixed_vector<input_event, N>& tos)
+    {
+        auto count = map(from, action_context, tos.end(),
+            tos.capacity() - tos.size());
+        tos.resize(tos.size() + count);
+        return count;
+    }
+
+private:
+    /// \brief Index of the bindings by the events they can map
+    input_dispatch_table _dispatch;
+
+    /// \brief Runtime state of the bindings, by context and then by binding
+    std::vector<std::vector<input_binding_state>> _states;
+
+    /// \brief Events produced by the last event advancing the bindings
+    std::vector<input_event> _mapped;
+
+    /// \brief Positions of the contexts by action ID
+    mutable std::unordered_map<std::size_t, std::size_t> _index;
+
+    /// \brief Number of contexts when the index was built
+    mutable std::size_t _indexed_count{0};
+
+    /// \brief Action context of the binding being captured
+    input_action_context const* _capture_context{nullptr};
+
+    /// \brief Action of the binding being captured, or null if no binding
+    /// is being captured
+    input_action const* _capture_action{nullptr};
+
+    /// \brief Index of the binding being captured within its context
+    std::size_t _capture_index{0};
+
+    bool _is_dirty{false}; //!< Whether the bindings have changed
+
+    /// \brief Rebuilds the index of contexts by action ID
+    void reindex() const;
+
+    /// \brief Rebuilds the dispatch table and resets the state of every
+    /// binding if contexts were added or removed since the last rebuild
+    void synchronize();
+
+    /// \brief Resets the state of every binding
+    void reset_states();
+
+    /// \brief Advances the bindings that depend on time to a new frame
+    /// \tparam Output type of function receiving produced events
+    /// \param time_step time elapsed in seconds
+    /// \param output function receiving each produced event and returning
+    /// whether more events can be received
+    /// \return number of events received by \p output
+    template <typename Output>
+    std::size_t advance(float time_step, Output output);
+
+    /// \brief Finds the position of the binding context for an action,
+    /// appending one if the map does not contain it
+    /// \param action_context action context of the binding context
+    /// \param action action of the binding context
+    /// \return position of the binding context
+    std::size_t position_of(
+        input_action_context const* action_context,
+        input_action const* action);
+
+    /// \brief Updates the dispatch table and index after the bindings of a
+    /// single context have changed, and marks the map as dirty
+    /// \param position position of the changed context
+    void changed(std::size_t position);
+
+    /// \brief Outputs the events mapped from the last event advancing the
+    /// bindings
+    /// \tparam Filter type of predicate selecting mapped events
+    /// \tparam Output type of function receiving mapped events
+    /// \param filter predicate selecting the mapped events to output
+    /// \param output function receiving each mapped event and returning
+    /// whether more events can be received
+    /// \return number of events received by \p output
+    template <typename Filter, typename Output>
+    std::size_t select(Filter filter, Output output) const;
 };
 
 /// \}
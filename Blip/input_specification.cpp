@@ -9,7 +9,6 @@
 #include "blip/input_specification.hpp"
 #include "blip/xml_deserializer.hpp"
 #include "blip/xml_serializer.hpp"
-#include <algorithm>
 #include <iterator>
 #include <stdexcept>
 #include <utility>
@@ -47,25 +46,54 @@ bool input_specification::erase(std::string const& n)
         return false;
     }
     contexts.erase(iter);
+    reindex();
     return true;
 }
 
+void input_specification::reindex()
+{
+    _actions.clear();
+    for (std::size_t c = 0; c < contexts.size(); ++c) {
+        auto& context = contexts[c];
+        context.id = c;
+        for (std::size_t a = 0; a < context.actions.size(); ++a) {
+            context.actions[a].id = _actions.size();
+            _actions.emplace_back(c, a);
+        }
+        context.reindex();
+    }
+    reindex_names();
+}
+
+void input_specification::reindex_names() const
+{
+    _index.clear();
+    for (std::size_t i = 0; i < contexts.size(); ++i) {
+        _index.emplace(contexts[i].name, i);
+    }
+    _indexed_count = contexts.size();
+}
+
 auto input_specification::find(std::string const& n) const
     -> decltype(contexts)::const_iterator
 {
-    auto first = std::begin(contexts);
-    auto last = std::end(contexts);
-    auto pred = [&n](auto& i) { return i.name == n; };
-    return std::find_if(first, last, pred);
+    if (_indexed_count != contexts.size()) {
+        reindex_names();
+    }
+    auto iter = _index.find(n);
+    if (iter == std::end(_index) || iter->second >= contexts.size()) {
+        return std::end(contexts);
+    }
+    auto pos = std::begin(contexts)
+        + static_cast<std::ptrdiff_t>(iter->second);
+    return pos->name == n ? pos : std::end(contexts);
 }
 
 auto input_specification::find(std::string const& n)
     -> decltype(contexts)::iterator
 {
-    auto first = std::begin(contexts);
-    auto last = std::end(contexts);
-    auto pred = [&n](auto& i) { return i.name == n; };
-    return std::find_if(first, last, pred);
+    auto iter = static_cast<input_specification const&>(*this).find(n);
+    return std::begin(contexts) + (iter - std::cbegin(contexts));
 }
 
 bool xml_converter<input_specification>::deserialize(
@@ -79,6 +107,7 @@ bool xml_converter<input_specification>::deserialize(
         }
         t.contexts.emplace_back(std::move(context));
     }
+    t.reindex();
     return true;
 }
 
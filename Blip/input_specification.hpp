@@ -9,7 +9,10 @@
 
 #include "blip/input_action_context.hpp"
 #include "blip/xml_converter.hpp"
+#include <cstddef>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace blip {
@@ -18,11 +21,34 @@ namespace blip {
 /// \{
 
 /// \brief Game-defined specification of possible input contexts
+///
+/// Contexts and actions are assigned dense integer IDs by \ref reindex, so
+/// callers can resolve names once and then look up by ID in constant time.
+/// Contexts are found by name through a hashed index, which is rebuilt
+/// automatically when contexts are added or removed; \ref reindex must be
+/// called after contexts or actions are otherwise modified.
 struct input_specification
 {
     /// \brief List of member action contexts
     std::vector<input_action_context> contexts;
 
+    /// \brief Assigns IDs to the contexts and actions and rebuilds the
+    /// indexes by name
+    void reindex();
+
+    /// \brief Gets the number of actions across every context
+    /// \return number of actions
+    std::size_t action_count() const noexcept { return _actions.size(); }
+
+    /// \brief Gets an action by ID
+    /// \param id ID of the action, less than \ref action_count
+    /// \return reference to the action
+    input_action const& action(std::size_t id) const
+    {
+        auto&& pos = _actions[id];
+        return contexts[pos.first].actions[pos.second];
+    }
+
     /// \brief Gets a context from the specification by name
     /// \param name name of the context
     /// \return reference to a context with the given name
@@ -55,6 +81,19 @@ struct input_specification
     /// \return iterator for the context
     auto find(std::string const& name)
         -> decltype(contexts)::iterator;
+
+private:
+    /// \brief Positions of the actions by ID, as context and action index
+    std::vector<std::pair<std::size_t, std::size_t>> _actions;
+
+    /// \brief Positions of the contexts by name
+    mutable std::unordered_map<std::string, std::size_t> _index;
+
+    /// \brief Number of contexts when the index was built
+    mutable std::size_t _indexed_count{0};
+
+    /// \brief Rebuilds the index of contexts by name
+    void reindex_names() const;
 };
 
 /// \}
@@ -0,0 +1,84 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::input_state class implementation
+/// \ingroup input
+
+#include "blip/input_state.hpp"
+#include "blip/input_action.hpp"
+#include "blip/input_binding.hpp"
+#include "blip/input_event.hpp"
+#include "blip/input_specification.hpp"
+#include <stdexcept>
+
+namespace blip {
+
+void input_state::reset(input_specification const& spec)
+{
+    _actions.assign(spec.action_count(), input_action_state{});
+    _keys.resize(spec.action_count());
+    for (std::size_t id = 0; id < _keys.size(); ++id) {
+        _keys[id] = &spec.action(id);
+    }
+}
+
+std::size_t input_state::id_of(input_action const* action) const
+{
+    if (action == nullptr || action->id >= _keys.size()
+        || _keys[action->id] != action) {
+        throw std::out_of_range{"action not found in state"};
+    }
+    return action->id;
+}
+
+void input_state::begin_frame() noexcept
+{
+    for (auto&& a : _actions) {
+        a.was_pressed = false;
+        a.was_released = false;
+    }
+}
+
+void input_state::apply(input_event const& event)
+{
+    auto action = event.action;
+    if (action == nullptr || action->id >= _keys.size()
+        || _keys[action->id] != action) {
+        return;
+    }
+    auto& a = _actions[action->id];
+
+    auto is_down = false;
+    switch (event.binding->signal()) {
+        case input_signal::analog:
+            a.value = event.value.analog;
+            is_down = a.value != 0.0f;
+            break;
+
+        case input_signal::digital:
+            a.value = event.value.digital ? 1.0f : 0.0f;
+            is_down = event.value.digital;
+            break;
+    }
+
+    if (is_down && !a.is_down) {
+        a.was_pressed = true;
+        a.held_time = 0.0f;
+    }
+    else if (!is_down && a.is_down) {
+        a.was_released = true;
+    }
+    a.is_down = is_down;
+}
+
+void input_state::update(float time_step) noexcept
+{
+    for (auto&& a : _actions) {
+        if (a.is_down) {
+            a.held_time += time_step;
+        }
+    }
+}
+
+}
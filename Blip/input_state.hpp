@@ -0,0 +1,106 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::input_state class interface
+/// \ingroup input
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace blip {
+
+// Forward declarations
+struct input_action;
+struct input_event;
+struct input_specification;
+
+/// \addtogroup input
+/// \{
+
+/// \brief Polled state of a single action
+struct input_action_state
+{
+    /// \brief Current value of the action
+    ///
+    /// Digital actions are 1 while down and 0 while up; analog actions hold
+    /// the value of their most recent event.
+    float value{0.0f};
+
+    bool is_down{false}; //!< Whether the action is down
+    bool was_pressed{false}; //!< Whether the action went down this frame
+    bool was_released{false}; //!< Whether the action went up this frame
+
+    /// \brief Time in seconds that the action has been down, or was down
+    /// before it was last released
+    float held_time{0.0f};
+};
+
+/// \brief Snapshot of every action's state, updated once per frame
+///
+/// Actions are identified by the dense integer IDs assigned by
+/// \ref input_specification::reindex, so the state of an action can be
+/// queried in constant time. When
+/// an action has several bindings, its state follows the most recent event
+/// from any of them.
+class input_state
+{
+public:
+    /// \brief Resets the state for the actions of a specification
+    /// \param spec input specification
+    void reset(input_specification const& spec);
+
+    /// \brief Gets the number of actions
+    /// \return number of actions
+    std::size_t size() const noexcept { return _actions.size(); }
+
+    /// \brief Gets the ID of an action
+    /// \param action action of the specification
+    /// \return ID of \p action
+    ///
+    /// Throws \ref std::out_of_range if the action is not in the
+    /// specification the state was reset with.
+    std::size_t id_of(input_action const* action) const;
+
+    /// \brief Gets the state of an action by ID
+    /// \param id ID of the action, less than \ref size
+    /// \return state of the action
+    input_action_state const& operator[](std::size_t id) const noexcept
+    {
+        return _actions[id];
+    }
+
+    /// \brief Gets the state of an action
+    /// \param action action of the specification
+    /// \return state of the action
+    input_action_state const& at(input_action const* action) const
+    {
+        return _actions[id_of(action)];
+    }
+
+    /// \brief Begins a new frame, clearing the pressed and released flags
+    void begin_frame() noexcept;
+
+    /// \brief Applies a mapped input event
+    /// \param event input event
+    ///
+    /// Events for actions that are not in the specification are ignored.
+    void apply(input_event const& event);
+
+    /// \brief Advances the held times of the actions that are down
+    /// \param time_step time elapsed in seconds
+    void update(float time_step) noexcept;
+
+private:
+    /// \brief States of the actions, indexed by ID
+    std::vector<input_action_state> _actions;
+
+    /// \brief Actions of the specification, indexed by ID
+    std::vector<input_action const*> _keys;
+};
+
+/// \}
+
+}
@@ -6,15 +6,150 @@
 /// \ingroup application
 
 #include "blip/application.hpp"
+#include "blip/lexical_cast.hpp"
+#include "blip/replay_event_source.hpp"
+#include "blip/string.hpp"
+#include "blip/synthetic_event_source.hpp"
+#include "blip/trace.hpp"
+#include <SFML/Window/Joystick.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+/// \brief Generates a repeatable stream of keyboard and joystick input
+/// \param seed random number generator seed
+/// \return event generation function
+///
+/// Only letter keys are pressed so that the generated input exercises the
+/// input map without triggering menu shortcuts such as escape.
+blip::synthetic_event_source::generator_type random_input(unsigned seed)
+{
+    return [rng = std::minstd_rand{seed}](
+        std::size_t,
+        std::vector<sf::Event>& events) mutable
+    {
+        std::uniform_int_distribution<int> count_dist{0, 4};
+        std::uniform_int_distribution<int> kind_dist{0, 2};
+        std::uniform_int_distribution<int> key_dist{sf::Keyboard::A,
+            sf::Keyboard::Z};
+        std::uniform_int_distribution<int> axis_dist{0,
+            sf::Joystick::AxisCount - 1};
+        std::uniform_real_distribution<float> position_dist{-100.0f, 100.0f};
+
+        for (auto n = count_dist(rng); n > 0; --n) {
+            sf::Event event;
+            switch (kind_dist(rng)) {
+                case 0:
+                case 1:
+                    event.type = kind_dist(rng) == 0
+                        ? sf::Event::KeyReleased
+                        : sf::Event::KeyPressed;
+                    event.key.code =
+                        static_cast<sf::Keyboard::Key>(key_dist(rng));
+                    event.key.alt = false;
+                    event.key.control = false;
+                    event.key.shift = false;
+                    event.key.system = false;
+                    break;
+
+                default:
+                    event.type = sf::Event::JoystickMoved;
+                    event.joystickMove.joystickId = 0;
+                    event.joystickMove.axis =
+                        static_cast<sf::Joystick::Axis>(axis_dist(rng));
+                    event.joystickMove.position = position_dist(rng);
+                    break;
+            }
+            events.emplace_back(event);
+        }
+    };
+}
+
+}
 
 /// \addtogroup application
 /// \{
 
 /// \brief The entry point of the program
+/// \param argc number of command line arguments
+/// \param argv command line arguments
 /// \return exit status of the program
-int main()
+///
+/// If the \c BLIP_TRACE environment variable is set, a trace is captured to
+/// the file it names for \c BLIP_TRACE_SECONDS seconds, or until exit.
+///
+/// The following options are accepted:
+/// - \c --headless runs in \ref blip::application_mode::headless, driven by
+///   generated input
+/// - \c --frames=N exits after \c N frames
+/// - \c --seed=N seeds the generated input of a headless run
+/// - \c --record=PATH records the input of the run to an event log
+/// - \c --replay=PATH replays the input of an event log, exiting at its end
+int main(int argc, char* argv[])
 {
-    return blip::application{}.run();
+    auto mode = blip::application_mode::windowed;
+    std::size_t frames{0};
+    unsigned seed{0};
+    std::string record_path;
+    std::string replay_path;
+    for (auto i = 1; i < argc; ++i) {
+        std::string arg{argv[i]};
+        std::string value;
+        if (arg == "--headless") {
+            mode = blip::application_mode::headless;
+        }
+        else if (blip::parse_option(arg, "--frames", value)) {
+            if (!blip::try_lexical_cast(value, frames)) {
+                std::cerr << "invalid frame count: " << value << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+        else if (blip::parse_option(arg, "--seed", value)) {
+            if (!blip::try_lexical_cast(value, seed)) {
+                std::cerr << "invalid seed: " << value << '\n';
+                return EXIT_FAILURE;
+            }
+        }
+        else if (blip::parse_option(arg, "--record", value)) {
+            record_path = value;
+        }
+        else if (blip::parse_option(arg, "--replay", value)) {
+            replay_path = value;
+        }
+        else {
+            std::cerr << "unknown option: " << arg << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (auto path = std::getenv("BLIP_TRACE")) {
+        unsigned seconds{0};
+        if (auto value = std::getenv("BLIP_TRACE_SECONDS")) {
+            blip::try_lexical_cast(std::string{value}, seconds);
+        }
+        blip::start_trace(path, std::chrono::seconds{seconds});
+    }
+
+    blip::application app{mode};
+    if (!replay_path.empty()) {
+        auto window = mode == blip::application_mode::windowed
+            ? &app.window()
+            : nullptr;
+        app.events(std::make_unique<blip::replay_event_source>(replay_path,
+            0.0f, window));
+    }
+    else if (mode == blip::application_mode::headless) {
+        app.events(std::make_unique<blip::synthetic_event_source>(
+            random_input(seed)));
+    }
+    if (!record_path.empty()) {
+        app.record_events(record_path);
+    }
+    return app.run(frames);
 }
 
 /// \}
@@ -7,7 +7,10 @@
 
 #include "blip/main_menu_state.hpp"
 #include "blip/application.hpp"
+#include "blip/path.hpp"
+#include "blip/xml_deserializer.hpp"
 #include <SFML/Window/Event.hpp>
+#include <utility>
 
 namespace blip {
 
@@ -15,6 +18,14 @@ main_menu_state::main_menu_state(application& a)
     : state{state_type::primary}
     , _app{a}
 {
+    pugi::xml_document doc;
+    resource_manifest manifest;
+    auto path = join_path({"Manifests", "MainMenu.xml"});
+    if (_app.resource_mgr().load_document(path, doc)
+        && xml_deserializer{doc}.child("ResourceManifest", manifest))
+    {
+        this->manifest(std::move(manifest));
+    }
 }
 
 bool main_menu_state::notify(const sf::Event& event)
@@ -0,0 +1,38 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::mapped_file class implementation
+/// \ingroup resource
+
+#include "blip/mapped_file.hpp"
+#include <utility>
+
+namespace blip {
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : _data{other._data}
+    , _size{other._size}
+{
+    other._data = nullptr;
+    other._size = 0;
+}
+
+mapped_file::~mapped_file()
+{
+    close();
+}
+
+mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        _data = other._data;
+        _size = other._size;
+        other._data = nullptr;
+        other._size = 0;
+    }
+    return *this;
+}
+
+}
@@ -0,0 +1,76 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::mapped_file class interface
+/// \ingroup resource
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Read-only view of a file mapped into memory
+///
+/// The contents are paged in by the operating system as they are read, so
+/// mapping a file costs little however large it is.
+class mapped_file
+{
+public:
+    /// \brief Initializes a new instance of the \ref mapped_file class that
+    /// maps no file
+    mapped_file() noexcept = default;
+
+    /// \brief Initializes a new instance of the \ref mapped_file class,
+    /// mapping a file
+    /// \param path path to the file
+    ///
+    /// Throws \ref std::runtime_error if the file cannot be mapped.
+    explicit mapped_file(std::string const& path);
+
+    /// \brief Move constructor
+    /// \param other file to move from, which is left mapping no file
+    mapped_file(mapped_file&& other) noexcept;
+
+    /// \brief Deleted copy constructor
+    mapped_file(mapped_file const&) = delete;
+
+    /// \brief Destructs the \ref mapped_file instance, unmapping the file
+    ~mapped_file();
+
+    /// \brief Move assignment operator
+    /// \param other file to move from, which is left mapping no file
+    /// \return reference to this file
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    /// \brief Deleted copy assignment operator
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    /// \brief Gets a value indicating whether a file is mapped
+    /// \return whether a file is mapped
+    bool is_open() const noexcept { return _data != nullptr; }
+
+    /// \brief Gets the contents of the file
+    /// \return pointer to the contents, or null if no file is mapped
+    char const* data() const noexcept { return _data; }
+
+    /// \brief Gets the size of the file
+    /// \return size in bytes
+    std::size_t size() const noexcept { return _size; }
+
+private:
+    /// \brief Unmaps the file, if any
+    void close() noexcept;
+
+    char const* _data{nullptr}; //!< Mapped contents
+    std::size_t _size{0}; //!< Size of the contents in bytes
+};
+
+/// \}
+
+}
@@ -8,6 +8,7 @@
 #include "blip/path.hpp"
 #include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <iterator>
 #include <sstream>
 
@@ -80,4 +81,14 @@ std::vector<std::string> split_path(std::string const& path)
     return parts;
 }
 
+std::size_t file_size(std::string const& path)
+{
+    std::ifstream is{path, std::ios::binary | std::ios::ate};
+    if (!is) {
+        return 0;
+    }
+    auto size = is.tellg();
+    return size > 0 ? static_cast<std::size_t>(size) : 0;
+}
+
 }
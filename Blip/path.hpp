@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -79,6 +80,17 @@ std::string find_system_path(system_path sys_path);
 /// \return whether the directory was created or already existed
 bool create_directory(std::string const& path);
 
+/// \brief Lists the files in a directory and its subdirectories
+/// \param path path to the directory
+/// \return paths of the files relative to \p path, or an empty list if the
+/// directory cannot be read
+std::vector<std::string> list_files(std::string const& path);
+
+/// \brief Gets the size of a file
+/// \param path path to the file
+/// \return size of the file in bytes, or 0 if it cannot be read
+std::size_t file_size(std::string const& path);
+
 /// \}
 
 }
@@ -0,0 +1,72 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::recording_event_source class
+/// implementation
+/// \ingroup application
+
+#include "blip/recording_event_source.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace blip {
+
+recording_event_source::recording_event_source(
+    std::unique_ptr<event_source>&& source,
+    std::string const& path)
+    : _log{path}
+    , _source{std::move(source)}
+    , _start{clock_type::now()}
+{
+    if (_source == nullptr) {
+        throw std::invalid_argument{"event source must not be null"};
+    }
+}
+
+recording_event_source::~recording_event_source()
+{
+    if (_has_started) {
+        _log.write(_frame);
+    }
+    _log.flush();
+}
+
+float recording_event_source::time_step(float measured)
+{
+    _time_step = _source->time_step(measured);
+    return _time_step;
+}
+
+void recording_event_source::next_frame()
+{
+    if (_has_started) {
+        _log.write(_frame);
+        ++_frame.index;
+    }
+    _has_started = true;
+
+    auto time = clock_type::now() - _start;
+    _frame.time = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(time).count());
+    _frame.time_step = _time_step;
+    _frame.events.clear();
+    _time_step = 0.0f;
+    _source->next_frame();
+}
+
+bool recording_event_source::poll(sf::Event& event)
+{
+    if (!_source->poll(event)) {
+        return false;
+    }
+    _frame.events.emplace_back(event);
+    return true;
+}
+
+bool recording_event_source::is_finished() const
+{
+    return _source->is_finished();
+}
+
+}
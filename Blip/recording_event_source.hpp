@@ -0,0 +1,77 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::recording_event_source class interface
+/// \ingroup application
+
+#pragma once
+
+#include "blip/event_log.hpp"
+#include "blip/event_source.hpp"
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Records the events supplied by another source to an event log
+///
+/// Every frame is recorded with its index, time and time step, including
+/// frames without events, so that a \ref replay_event_source can reproduce
+/// the session exactly.
+class recording_event_source : public event_source
+{
+public:
+    /// \brief Initializes a new instance of the
+    /// \ref recording_event_source class with the given source and log
+    /// \param source event source to record
+    /// \param path path to the event log, which is replaced
+    ///
+    /// Throws \ref std::invalid_argument if \p source is null, or
+    /// \ref std::runtime_error if the log cannot be opened, in which case
+    /// \p source is left unchanged.
+    recording_event_source(
+        std::unique_ptr<event_source>&& source,
+        std::string const& path);
+
+    /// \brief Destructs the \ref recording_event_source instance, writing
+    /// the last frame to the log
+    ~recording_event_source();
+
+    /// \brief Gets the time step of the next frame from the recorded source
+    /// \param measured time step measured by the \ref application
+    /// \return time step to use for the frame
+    float time_step(float measured) override;
+
+    /// \brief Writes the current frame to the log and prepares the next
+    void next_frame() override;
+
+    /// \brief Pops and records the next pending event of the current frame
+    /// \param event event to pop into
+    /// \return whether an event was popped
+    bool poll(sf::Event& event) override;
+
+    /// \brief Gets a value indicating whether the recorded source has no
+    /// more events
+    /// \return whether the recorded source is exhausted
+    bool is_finished() const override;
+
+private:
+    /// \brief Type of clock used for frame times
+    using clock_type = std::chrono::steady_clock;
+
+    event_log_writer _log; //!< Event log being written
+    std::unique_ptr<event_source> _source; //!< Event source being recorded
+    event_log_frame _frame; //!< Frame being recorded
+    float _time_step{0.0f}; //!< Time step of the next frame
+    clock_type::time_point _start; //!< Time at which recording began
+    bool _has_started{false}; //!< Whether a frame has been prepared
+};
+
+/// \}
+
+}
@@ -0,0 +1,71 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::replay_event_source class implementation
+/// \ingroup application
+
+#include "blip/replay_event_source.hpp"
+#include <SFML/Window/Window.hpp>
+
+namespace blip {
+
+replay_event_source::replay_event_source(
+    std::string const& path,
+    float time_step,
+    sf::Window* window)
+    : _log{path}
+    , _time_step{time_step}
+    , _window{window}
+{
+}
+
+float replay_event_source::time_step(float measured)
+{
+    // The time step precedes the frame's events, so read the frame early
+    if (!_is_read_ahead) {
+        read();
+    }
+    if (_is_finished) {
+        return measured;
+    }
+    return _time_step > 0.0f ? _time_step : _frame.time_step;
+}
+
+void replay_event_source::next_frame()
+{
+    if (!_is_read_ahead) {
+        read();
+    }
+    _is_read_ahead = false;
+    _next = 0;
+}
+
+bool replay_event_source::poll(sf::Event& event)
+{
+    if (_next < _frame.events.size()) {
+        event = _frame.events[_next++];
+        return true;
+    }
+
+    // A window that is not polled is reported as unresponsive by the system
+    if (_window != nullptr) {
+        while (_window->pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void replay_event_source::read()
+{
+    _is_read_ahead = true;
+    if (_is_finished || !_log.read(_frame)) {
+        _is_finished = true;
+        _frame.events.clear();
+    }
+}
+
+}
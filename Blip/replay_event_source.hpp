@@ -0,0 +1,94 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::replay_event_source class interface
+/// \ingroup application
+
+#pragma once
+
+#include "blip/event_log.hpp"
+#include "blip/event_source.hpp"
+#include <cstddef>
+#include <string>
+
+namespace sf {
+
+// Forward declarations
+class Window;
+
+}
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Supplies the events of an event log recorded by a
+/// \ref recording_event_source
+///
+/// Each frame supplies the events recorded in the corresponding frame and
+/// overrides the measured time step with the recorded one, so the
+/// \ref application updates exactly as it did while recording regardless of
+/// how quickly the replay runs. The source is finished once every recorded
+/// frame has been supplied.
+///
+/// When replaying into a window, the window's own events are drained after
+/// the recorded events of each frame so that it remains responsive. They are
+/// dropped so that they cannot change the replay, except for close events,
+/// which are supplied so that the window can still be closed.
+class replay_event_source : public event_source
+{
+public:
+    /// \brief Initializes a new instance of the \ref replay_event_source
+    /// class with the given log
+    /// \param path path to the event log
+    /// \param time_step time step to use for every frame, or zero to use
+    /// the recorded time steps
+    /// \param window window to drain events from, or null
+    ///
+    /// Throws \ref std::runtime_error if the log cannot be opened.
+    explicit replay_event_source(
+        std::string const& path,
+        float time_step = 0.0f,
+        sf::Window* window = nullptr);
+
+    /// \brief Gets the index of the current frame
+    /// \return index of the current frame
+    std::size_t frame() const noexcept { return _frame.index; }
+
+    /// \brief Gets the time step of the next recorded frame
+    /// \param measured time step measured by the \ref application
+    /// \return recorded time step, or \p measured once finished
+    float time_step(float measured) override;
+
+    /// \brief Reads the events of the next recorded frame
+    void next_frame() override;
+
+    /// \brief Pops the next recorded event of the current frame, or the
+    /// next close event of the window
+    /// \param event event to pop into
+    /// \return whether an event was popped
+    bool poll(sf::Event& event) override;
+
+    /// \brief Gets a value indicating whether every recorded frame has been
+    /// supplied
+    /// \return whether the log is exhausted
+    bool is_finished() const override { return _is_finished; }
+
+private:
+    event_log_reader _log; //!< Event log being read
+    event_log_frame _frame; //!< Frame being supplied
+    float _time_step; //!< Time step override, or zero
+    sf::Window* _window; //!< Window to drain events from, or null
+    std::size_t _next{0}; //!< Index of the next event to pop
+    bool _is_read_ahead{false}; //!< Whether the next frame has been read
+    bool _is_finished{false}; //!< Whether the log is exhausted
+
+    /// \brief Reads the next frame from the log
+    void read();
+};
+
+/// \}
+
+}
@@ -0,0 +1,234 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::resource_archive class implementation
+/// \ingroup resource
+
+#include "blip/resource_archive.hpp"
+#include "blip/path.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+using namespace blip;
+
+/// \brief Bytes identifying a resource archive
+constexpr std::array<char, 8> magic{{'B', 'L', 'I', 'P', 'P', 'A', 'C', 'K'}};
+
+/// \brief Version of the resource archive format
+constexpr std::uint32_t version = 1;
+
+/// \brief Alignment of file contents within the archive, in bytes
+constexpr std::uint64_t blob_alignment = 16;
+
+/// \brief Size of the archive header in bytes
+constexpr std::size_t header_size = magic.size() + 8;
+
+/// \brief Size of an index record in bytes, excluding the path
+constexpr std::size_t record_size = 20;
+
+/// \brief Converts a path to the form stored in archives
+/// \param path path with any separators
+/// \return path with forward slash separators and no leading separator
+std::string archive_path(std::string const& path)
+{
+    std::string result;
+    for (auto part : split_path(path)) {
+        part = trim_path(part);
+        if (part.empty()) {
+            continue;
+        }
+        if (!result.empty()) {
+            result += '/';
+        }
+        result += part;
+    }
+    return result;
+}
+
+/// \brief Writes an unsigned integer in little-endian byte order
+/// \param os stream to write to
+/// \param value value to write
+/// \param size number of bytes to write
+void put(std::ostream& os, std::uint64_t value, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        os.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+/// \brief Reads an unsigned integer in little-endian byte order
+/// \param data bytes to read from
+/// \param size number of bytes to read
+/// \return value read
+std::uint64_t get(char const* data, std::size_t size)
+{
+    std::uint64_t value{0};
+    for (std::size_t i = 0; i < size; ++i) {
+        auto byte = static_cast<unsigned char>(data[i]);
+        value |= static_cast<std::uint64_t>(byte) << (i * 8);
+    }
+    return value;
+}
+
+/// \brief Rounds an offset up to the alignment of file contents
+/// \param offset offset to align
+/// \return aligned offset
+std::uint64_t align_blob(std::uint64_t offset)
+{
+    return (offset + blob_alignment - 1) / blob_alignment * blob_alignment;
+}
+
+}
+
+namespace blip {
+
+resource_archive::resource_archive(std::string const& path)
+    : _file{path}
+{
+    auto data = _file.data();
+    auto size = _file.size();
+    if (size < header_size
+        || std::memcmp(data, magic.data(), magic.size()) != 0)
+    {
+        throw std::runtime_error{"file is not a resource archive"};
+    }
+    if (get(data + magic.size(), 4) != version) {
+        throw std::runtime_error{"unsupported resource archive version"};
+    }
+
+    auto count = static_cast<std::size_t>(get(data + magic.size() + 4, 4));
+    auto pos = header_size;
+    _entries.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (size - pos < record_size) {
+            throw std::runtime_error{"resource archive index is truncated"};
+        }
+        auto offset = get(data + pos, 8);
+        auto blob_size = get(data + pos + 8, 8);
+        auto path_size = static_cast<std::size_t>(get(data + pos + 16, 4));
+        pos += record_size;
+        if (size - pos < path_size) {
+            throw std::runtime_error{"resource archive index is truncated"};
+        }
+        if (offset > size || blob_size > size - offset) {
+            throw std::runtime_error{"resource archive file is truncated"};
+        }
+
+        entry_type entry;
+        entry.path.assign(data + pos, path_size);
+        entry.blob.data = data + offset;
+        entry.blob.size = static_cast<std::size_t>(blob_size);
+        pos += path_size;
+        if (!_entries.empty() && !(_entries.back().path < entry.path)) {
+            throw std::runtime_error{"resource archive index is unsorted"};
+        }
+        _entries.emplace_back(std::move(entry));
+    }
+}
+
+resource_blob resource_archive::find(std::string const& path) const
+{
+    auto key = archive_path(path);
+    auto iter = std::lower_bound(std::begin(_entries), std::end(_entries),
+        key, [](entry_type const& entry, std::string const& k)
+        {
+            return entry.path < k;
+        });
+    if (iter == std::end(_entries) || iter->path != key) {
+        return {};
+    }
+    return iter->blob;
+}
+
+void resource_archive::pack(
+    std::string const& archive_path,
+    std::string const& root,
+    std::vector<std::string> const& paths)
+{
+    if (paths.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error{"too many files to pack"};
+    }
+
+    // Files are sized up front so that the index can be written first
+    struct file_type
+    {
+        std::string path; //!< Path as stored in the archive
+        std::string source; //!< Path to read the contents from
+        std::uint64_t size; //!< Size of the contents
+        std::uint64_t offset; //!< Offset of the contents in the archive
+    };
+    std::vector<file_type> files;
+    std::uint64_t index_size{0};
+    for (auto&& path : paths) {
+        auto source = join_path({root, path});
+        std::ifstream is{source, std::ios::binary | std::ios::ate};
+        if (!is) {
+            throw std::runtime_error{"unable to read " + source};
+        }
+        auto size = static_cast<std::uint64_t>(is.tellg());
+        files.push_back({::archive_path(path), source, size, 0});
+        index_size += record_size + files.back().path.size();
+    }
+    std::sort(std::begin(files), std::end(files),
+        [](file_type const& a, file_type const& b)
+        {
+            return a.path < b.path;
+        });
+    auto duplicate = std::adjacent_find(std::begin(files), std::end(files),
+        [](file_type const& a, file_type const& b)
+        {
+            return a.path == b.path;
+        });
+    if (duplicate != std::end(files)) {
+        throw std::runtime_error{"duplicate path " + duplicate->path};
+    }
+
+    auto offset = align_blob(header_size + index_size);
+    for (auto&& file : files) {
+        file.offset = offset;
+        offset = align_blob(offset + file.size);
+    }
+
+    std::ofstream os{archive_path, std::ios::binary | std::ios::trunc};
+    if (!os) {
+        throw std::runtime_error{"unable to write " + archive_path};
+    }
+    os.write(magic.data(), magic.size());
+    put(os, version, 4);
+    put(os, files.size(), 4);
+    for (auto&& file : files) {
+        put(os, file.offset, 8);
+        put(os, file.size, 8);
+        put(os, file.path.size(), 4);
+        os.write(file.path.data(),
+            static_cast<std::streamsize>(file.path.size()));
+    }
+    for (auto&& file : files) {
+        while (static_cast<std::uint64_t>(os.tellp()) < file.offset) {
+            os.put('\0');
+        }
+        std::ifstream is{file.source, std::ios::binary};
+        if (file.size > 0 && !(os << is.rdbuf())) {
+            throw std::runtime_error{"unable to read " + file.source};
+        }
+        auto end = static_cast<std::uint64_t>(os.tellp());
+        if (end != file.offset + file.size) {
+            throw std::runtime_error{file.source + " changed while packing"};
+        }
+    }
+    if (!os.flush()) {
+        throw std::runtime_error{"unable to write " + archive_path};
+    }
+}
+
+}
@@ -0,0 +1,96 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::resource_archive class interface
+/// \ingroup resource
+
+#pragma once
+
+#include "blip/mapped_file.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Contents of a file in a \ref resource_archive
+struct resource_blob
+{
+    char const* data{nullptr}; //!< Contents, or null if there is no file
+    std::size_t size{0}; //!< Size of the contents in bytes
+};
+
+/// \brief Read-only archive packing many resource files into one
+///
+/// The archive is mapped into memory, and the contents of its files are
+/// handed out in place, without being copied. They remain valid for as long
+/// as the archive is open.
+///
+/// An archive begins with the bytes "BLIPPACK", the format version, and the
+/// number of files, followed by an index of the files sorted by path. Each
+/// index record holds the offset and size of a file, the length of its
+/// path, and the path. The contents of the files follow, each aligned to 16
+/// bytes. Integers are stored little-endian, with offsets and sizes in 64
+/// bits and all else in 32. Paths are relative to the resources directory
+/// and are separated by forward slashes.
+class resource_archive
+{
+public:
+    /// \brief Initializes a new instance of the \ref resource_archive class
+    /// with no files
+    resource_archive() = default;
+
+    /// \brief Initializes a new instance of the \ref resource_archive class
+    /// by opening an archive
+    /// \param path path to the archive
+    ///
+    /// Throws \ref std::runtime_error if the archive cannot be mapped or is
+    /// malformed.
+    explicit resource_archive(std::string const& path);
+
+    /// \brief Gets a value indicating whether an archive is open
+    /// \return whether an archive is open
+    bool is_open() const noexcept { return _file.is_open(); }
+
+    /// \brief Gets the number of files in the archive
+    /// \return number of files
+    std::size_t size() const noexcept { return _entries.size(); }
+
+    /// \brief Finds a file in the archive
+    /// \param path path to the file, relative to the resources directory,
+    /// with any separator
+    /// \return contents of the file, which are null if it is not in the
+    /// archive
+    resource_blob find(std::string const& path) const;
+
+    /// \brief Packs files into a new archive
+    /// \param archive_path path to the archive, which is replaced
+    /// \param root path to the resources directory
+    /// \param paths paths of the files to pack, relative to \p root
+    ///
+    /// Throws \ref std::runtime_error if a file cannot be read or the
+    /// archive cannot be written.
+    static void pack(
+        std::string const& archive_path,
+        std::string const& root,
+        std::vector<std::string> const& paths);
+
+private:
+    /// \brief Index record of a file in the archive
+    struct entry_type
+    {
+        std::string path; //!< Path with forward slash separators
+        resource_blob blob; //!< Contents of the file
+    };
+
+    mapped_file _file; //!< Mapped archive
+    std::vector<entry_type> _entries; //!< Index sorted by path
+};
+
+/// \}
+
+}
@@ -9,6 +9,8 @@
 
 namespace blip {
 
+resource_cache::prefetch_type::~prefetch_type() = default;
+
 resource_cache::~resource_cache() = default;
 
 }
@@ -7,12 +7,30 @@
 
 #pragma once
 
+#include "blip/resource_handle.hpp"
+#include "blip/string_key.hpp"
+#include "blip/string_map.hpp"
+#include "blip/trace.hpp"
+#include "blip/worker_pool.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <functional>
+#include <future>
 #include <iterator>
-#include <map>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 namespace blip {
 
@@ -23,15 +41,88 @@ namespace blip {
 class resource_cache
 {
 public:
+    /// \brief Interface for a resource being prefetched, which holds the
+    /// resource until destroyed
+    struct prefetch_type
+    {
+        /// \brief Destructs the \ref prefetch_type instance
+        virtual ~prefetch_type();
+
+        /// \brief Gets a value indicating whether the resource has been
+        /// created, or could not be
+        /// \return whether the prefetch is finished
+        virtual bool is_ready() const = 0;
+    };
+
     /// \brief Destructs the \ref resource_cache instance
     virtual ~resource_cache();
 
+    /// \brief Gets the type of resource held by the cache
+    /// \return type of resource
+    virtual std::type_index type() const noexcept = 0;
+
     /// \brief Sweeps the cache, removing expired resources
     virtual void sweep() = 0;
+
+    /// \brief Starts creating a resource asynchronously, unless it exists
+    /// \param name name of the resource
+    /// \param workers pool to create the resource on
+    /// \return prefetch holding the resource
+    virtual std::unique_ptr<prefetch_type> prefetch(
+        std::string const& name,
+        worker_pool& workers) = 0;
+
+    /// \brief Starts recreating a resource in use, so that its contents
+    /// can be replaced in place
+    /// \param name name of the resource
+    /// \param workers pool to recreate the resource on
+    /// \return whether the resource is being recreated
+    virtual bool reload(std::string const& name, worker_pool& workers) = 0;
+
+    /// \brief Replaces the contents of resources that have been recreated
+    /// \return number of resources replaced
+    virtual std::size_t apply_reloads() = 0;
 };
 
 /// \brief Typed cache for resources
 /// \tparam T type of resource
+///
+/// Resources are held weakly, so they are destroyed when the last pointer
+/// to them is released. Resources requested through \ref get_async are
+/// created on a \ref worker_pool and held strongly until they are first
+/// retrieved or the cache is swept.
+///
+/// A retention budget may be set so that the most recently used resources
+/// are also held strongly, up to a total estimated size, and survive being
+/// released briefly, such as between states. When the budget is exceeded,
+/// the least recently used resources are released first. Sizes are given
+/// by a size estimator, which defaults to the size of \p T.
+///
+/// The cache may be used from any number of threads. Names are spread over
+/// \ref shard_count independently locked shards, so lookups of different
+/// names rarely contend, and no lock is held while a resource is created.
+/// Each shard is a \ref string_map, looked up by \ref string_key so that
+/// names given as literals are not copied, and names given as a
+/// \ref resource_handle are not hashed either.
+/// Each resource is created only once however many threads request it at
+/// the same time; the others wait for the first to finish.
+///
+/// Resources that are created in stages, some of which must run on a
+/// particular thread, can be given an asynchronous creator that starts the
+/// stages and returns a future for the result. A synchronous \ref get
+/// waits for such a creation, so that each resource is created once,
+/// except on the thread named by \ref async_thread, which must finish it
+/// and so creates the resource itself instead. That instance is then kept
+/// in place of the asynchronous one.
+///
+/// A resource in use can be reloaded, such as when its file changes. It is
+/// recreated on a \ref worker_pool and assigned over the existing resource
+/// by \ref apply_reloads, so that every pointer to it sees the new
+/// contents. \p T must therefore be copy or move assignable. Resources
+/// whose stages must run on a particular thread can be given an
+/// asynchronous reloader, which starts the stages like an asynchronous
+/// creator but must not take its inputs from caches, since they may still
+/// hold the contents from before the change.
 template <typename T>
 class typed_resource_cache : public resource_cache
 {
@@ -48,14 +139,45 @@ public:
     /// \brief type of resource creation function
     using creator_type = std::function<ptr_type(name_type const&)>;
 
+    /// \brief Type of future for resources created asynchronously
+    using future_type = std::shared_future<ptr_type>;
+
+    /// \brief Type of function starting the asynchronous creation of a
+    /// resource, which must not block
+    using async_creator_type =
+        std::function<future_type(name_type const&, worker_pool&)>;
+
+    /// \brief Type of function estimating the memory used by a resource, in
+    /// bytes
+    using size_estimator_type =
+        std::function<std::size_t(name_type const&, T const&)>;
+
+    /// \brief Number of independently locked shards
+    static constexpr std::size_t shard_count = 16;
+
     /// \brief Initializes a new instance of the \ref typed_resource_cache
     /// class with the given creator
-    /// \param creator resource creation function
+    /// \param creator resource creation function, which must be safe to
+    /// call from several threads at once
     explicit typed_resource_cache(creator_type creator)
         : _creator{std::move(creator)}
     {
     }
 
+    /// \brief Initializes a new instance of the \ref typed_resource_cache
+    /// class with the given creators
+    /// \param creator resource creation function, which must be safe to
+    /// call from several threads at once
+    /// \param async_creator function starting the asynchronous creation of
+    /// a resource, used by \ref get_async
+    typed_resource_cache(
+        creator_type creator,
+        async_creator_type async_creator)
+        : _creator{std::move(creator)}
+        , _async_creator{std::move(async_creator)}
+    {
+    }
+
     /// \brief Deleted copy constructor
     typed_resource_cache(typed_resource_cache const&) = delete;
 
@@ -65,60 +187,616 @@ public:
     /// \brief Deleted copy assignment operator
     typed_resource_cache& operator=(typed_resource_cache const&) = delete;
 
+    /// \brief Gets the retention budget
+    /// \return budget in bytes, or 0 if resources are not retained
+    std::size_t retention_budget() const noexcept
+    {
+        return _retention_budget;
+    }
+
+    /// \brief Sets the retention budget, releasing resources to fit it
+    /// \param budget budget in bytes, or 0 to retain no resources
+    void retention_budget(std::size_t budget)
+    {
+        std::vector<ptr_type> released;
+        {
+            std::lock_guard<std::mutex> lock{_retained_mutex};
+            _retention_budget = budget;
+            evict(released);
+        }
+    }
+
+    /// \brief Sets the function estimating the size of resources
+    /// \param estimator size estimator, or empty to use the size of \p T
+    ///
+    /// Only resources retained from then on are estimated with it.
+    void size_estimator(size_estimator_type estimator)
+    {
+        std::lock_guard<std::mutex> lock{_retained_mutex};
+        _size_estimator = std::move(estimator);
+    }
+
+    /// \brief Sets the thread that finishes asynchronous creations, such as
+    /// the thread uploading textures
+    /// \param id identifier of the thread, or a default identifier if
+    /// asynchronous creations finish without the help of any caller
+    ///
+    /// A synchronous \ref get on this thread never waits for an
+    /// asynchronous creation, which could not finish while it waited.
+    void async_thread(std::thread::id id) noexcept
+    {
+        _async_thread = id;
+    }
+
+    /// \brief Sets the function starting the asynchronous recreation of
+    /// resources by \ref reload
+    /// \param reloader asynchronous reloader, or empty to call the
+    /// synchronous creator on the workers
+    void async_reloader(async_creator_type reloader)
+    {
+        std::lock_guard<std::mutex> lock{_reloads_mutex};
+        _async_reloader = std::move(reloader);
+    }
+
+    /// \brief Gets the estimated size of the retained resources
+    /// \return size in bytes
+    std::size_t retained_size() const
+    {
+        std::lock_guard<std::mutex> lock{_retained_mutex};
+        return _retained_size;
+    }
+
+    /// \brief Gets the number of retained resources
+    /// \return number of resources
+    std::size_t retained_count() const
+    {
+        std::lock_guard<std::mutex> lock{_retained_mutex};
+        return _retained.size();
+    }
+
+    /// \brief Releases all retained resources
+    ///
+    /// Resources still in use elsewhere remain in the cache, and are
+    /// retained again when next retrieved.
+    void release_retained()
+    {
+        std::list<retained_type> released;
+        {
+            std::lock_guard<std::mutex> lock{_retained_mutex};
+            released.swap(_retained);
+            _retained_index.clear();
+            _retained_size = 0;
+        }
+    }
+
+    /// \brief Gets the type of resource held by the cache
+    /// \return type of resource
+    virtual std::type_index type() const noexcept
+    {
+        return typeid(T);
+    }
+
     /// \brief Sweeps the cache, removing expired resources
     virtual void sweep()
     {
-        auto iter = std::begin(_resources);
-        auto last = std::end(_resources);
-        while (iter != last) {
-            if (iter->second.expired()) {
-                iter = _resources.erase(iter);
-            }
-            else {
-                ++iter;
-            }
+        // Resources created asynchronously would expire once taken from
+        // their futures, so they are retained first
+        std::vector<std::pair<name_type, ptr_type>> created;
+        for (auto&& shard : _shards) {
+            std::lock_guard<std::mutex> lock{shard.mutex};
+            shard.entries.erase_if([this, &created](
+                name_type const& name,
+                entry_type& entry)
+            {
+                if (entry.pending.valid() && is_ready(entry.pending)) {
+                    // A resource created synchronously in the meantime is
+                    // kept, as it is already in use
+                    if (entry.resource.expired()) {
+                        auto ptr = get_ready(entry.pending);
+                        entry.resource = ptr;
+                        if (ptr != nullptr && _retention_budget > 0) {
+                            created.emplace_back(name, std::move(ptr));
+                        }
+                    }
+                    entry.pending = {};
+                }
+                return !entry.is_creating && !entry.pending.valid()
+                    && entry.resource.expired();
+            });
+        }
+        for (auto&& pair : created) {
+            retain(pair.first, pair.second);
         }
     }
 
     /// \brief Gets an existing resource by name
-    /// \param name name of the resource
+    /// \param name name of the resource, or a \ref resource_handle for it
     /// \return pointer to the resource
-    virtual ptr_type get(name_type const& name) const
+    virtual ptr_type get(string_key name) const
     {
-        auto iter = _resources.find(name);
-        if (iter == std::end(_resources) || iter->second.expired()) {
-            return nullptr;
+        ptr_type ptr;
+        {
+            auto& shard = shard_for(name);
+            std::lock_guard<std::mutex> lock{shard.mutex};
+            auto entry = shard.entries.find(name);
+            if (entry == nullptr) {
+                return nullptr;
+            }
+            ptr = entry->resource.lock();
+            if (ptr == nullptr && entry->pending.valid()
+                && is_ready(entry->pending))
+            {
+                ptr = get_ready(entry->pending);
+            }
         }
-        return iter->second.lock();
+        retain(name, ptr);
+        return ptr;
     }
 
     /// \brief Gets a resource by name
-    /// \param name name of the resource
+    /// \param name name of the resource, or a \ref resource_handle for it
     /// \return pointer to the resource
     ///
-    /// If the resource does not exist, it is created.
-    virtual ptr_type get(name_type const& name)
+    /// If the resource does not exist, it is created on the calling thread.
+    /// If it is already being created, by another thread or asynchronously,
+    /// that creation is waited for instead, unless it was started by an
+    /// asynchronous creator and the calling thread is the
+    /// \ref async_thread. The name is only copied if the resource is
+    /// created.
+    virtual ptr_type get(string_key name)
+    {
+        auto& shard = shard_for(name);
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        auto entry = shard.entries.find(name);
+        while (entry != nullptr) {
+            auto ptr = entry->resource.lock();
+            if (ptr != nullptr) {
+                lock.unlock();
+                retain(name, ptr);
+                return ptr;
+            }
+            if (entry->pending.valid()) {
+                auto future = entry->pending;
+                if (is_ready(future)) {
+                    ptr = get_ready(future);
+                    entry->resource = ptr;
+                    entry->pending = {};
+                    lock.unlock();
+                    retain(name, ptr);
+                    return ptr;
+                }
+                if (!_async_creator
+                    || std::this_thread::get_id() != _async_thread)
+                {
+                    lock.unlock();
+                    ptr = get_ready(future);
+                    retain(name, ptr);
+                    return ptr;
+                }
+            }
+            if (!entry->is_creating) {
+                break;
+            }
+
+            // The entry may be swept or moved while waiting, so it is found
+            // again
+            shard.created.wait(lock);
+            entry = shard.entries.find(name);
+        }
+
+        // The creation is published in the entry so that other threads wait
+        // for it rather than creating the resource again. Entries being
+        // created are never swept, but may be moved as others come and go,
+        // so the entry is found again once the resource is created.
+        (entry != nullptr ? *entry : shard.entries[name]).is_creating = true;
+        lock.unlock();
+
+        auto owned_name = name.str();
+        ptr_type ptr;
+        try {
+            trace_scope trace{"Load resource", owned_name.c_str()};
+            ptr = _creator(owned_name);
+        }
+        catch (...) {
+            finish(shard, name, nullptr, std::current_exception());
+            throw;
+        }
+        finish(shard, name, ptr, nullptr);
+        retain(name, ptr);
+        return ptr;
+    }
+
+    /// \brief Gets a resource by name, creating it asynchronously
+    /// \param name name of the resource
+    /// \param workers pool to create the resource on
+    /// \return future for the pointer to the resource
+    ///
+    /// If the resource exists, the future is ready immediately. Otherwise it
+    /// becomes ready once the resource has been created on \p workers, or by
+    /// the thread already creating it. A resource is only created once,
+    /// however many times it is requested before it is ready. The pointer is
+    /// null if the resource could not be created.
+    virtual future_type get_async(
+        string_key name,
+        worker_pool& workers)
+    {
+        auto& shard = shard_for(name);
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        auto& entry = shard.entries[name];
+        auto ptr = entry.resource.lock();
+        if (ptr != nullptr) {
+            lock.unlock();
+            retain(name, ptr);
+            std::promise<ptr_type> promise;
+            promise.set_value(std::move(ptr));
+            return promise.get_future().share();
+        }
+        if (entry.pending.valid()) {
+            return entry.pending;
+        }
+
+        if (entry.is_creating) {
+            // The thread creating the resource satisfies the promise
+            entry.promise = std::make_shared<std::promise<ptr_type>>();
+            entry.pending = entry.promise->get_future().share();
+            return entry.pending;
+        }
+        if (_async_creator) {
+            entry.pending = _async_creator(name.str(), workers);
+            return entry.pending;
+        }
+
+        // The task owns copies of everything it uses, so the cache may be
+        // destroyed while the resource is being created
+        auto promise = std::make_shared<std::promise<ptr_type>>();
+        entry.pending = promise->get_future().share();
+        workers.submit([creator = _creator, name = name.str(), promise]
+        {
+            try {
+                trace_scope trace{"Load resource", name.c_str()};
+                promise->set_value(creator(name));
+            }
+            catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return entry.pending;
+    }
+
+    /// \brief Starts creating a resource asynchronously, unless it exists
+    /// \param name name of the resource
+    /// \param workers pool to create the resource on
+    /// \return prefetch holding the resource
+    /// \see get_async
+    virtual std::unique_ptr<prefetch_type> prefetch(
+        std::string const& name,
+        worker_pool& workers)
+    {
+        return std::make_unique<typed_prefetch_type>(get_async(name, workers));
+    }
+
+    /// \brief Starts recreating a resource in use, so that its contents
+    /// can be replaced in place
+    /// \param name name of the resource
+    /// \param workers pool to recreate the resource on
+    /// \return whether the resource is being recreated
+    ///
+    /// Resources not in use are not recreated, since they are created anew
+    /// when next requested. The resource is recreated with the
+    /// asynchronous reloader if there is one, or else with the synchronous
+    /// creator, as the stages of the asynchronous creator may be satisfied
+    /// by resources that are themselves being reloaded.
+    virtual bool reload(std::string const& name, worker_pool& workers)
     {
-        auto iter = _resources.find(name);
-        if (iter != std::end(_resources) && !iter->second.expired()) {
-            return iter->second.lock();
+        ptr_type ptr;
+        {
+            auto& shard = shard_for(name);
+            std::lock_guard<std::mutex> lock{shard.mutex};
+            auto entry = shard.entries.find(name);
+            if (entry == nullptr) {
+                return false;
+            }
+            ptr = entry->resource.lock();
         }
-        auto ptr = _creator(name);
         if (ptr == nullptr) {
-            return nullptr;
+            return false;
         }
-        if (iter != std::end(_resources)) {
-            iter->second = ptr;
+
+        async_creator_type reloader;
+        {
+            std::lock_guard<std::mutex> lock{_reloads_mutex};
+            reloader = _async_reloader;
+        }
+
+        future_type future;
+        if (reloader) {
+            future = reloader(name, workers);
         }
         else {
-            _resources.emplace(name, ptr);
+            auto promise = std::make_shared<std::promise<ptr_type>>();
+            future = promise->get_future().share();
+            workers.submit([creator = _creator, name, promise]
+            {
+                try {
+                    trace_scope trace{"Reload resource", name.c_str()};
+                    promise->set_value(creator(name));
+                }
+                catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            });
         }
-        return ptr;
+
+        std::lock_guard<std::mutex> lock{_reloads_mutex};
+        _reloads.push_back({ptr, std::move(future)});
+        return true;
+    }
+
+    /// \brief Replaces the contents of resources that have been recreated
+    /// \return number of resources replaced
+    ///
+    /// Must be called where the resources are not in use on another
+    /// thread, such as on the main thread between frames. Resources that
+    /// could not be recreated keep their contents.
+    ///
+    /// The contents are replaced by assignment, so objects that refer to a
+    /// resource are affected as its assignment operator dictates. Notably,
+    /// assigning to an \ref sf::SoundBuffer stops and detaches the sounds
+    /// playing it, which must be given the buffer again.
+    virtual std::size_t apply_reloads()
+    {
+        std::vector<reload_type> finished;
+        {
+            std::lock_guard<std::mutex> lock{_reloads_mutex};
+            auto iter = std::partition(std::begin(_reloads),
+                std::end(_reloads), [](reload_type const& reload)
+                {
+                    return !is_ready(reload.future);
+                });
+            std::move(iter, std::end(_reloads), std::back_inserter(finished));
+            _reloads.erase(iter, std::end(_reloads));
+        }
+
+        std::size_t count{0};
+        for (auto&& reload : finished) {
+            auto target = reload.target.lock();
+            auto ptr = get_ready(reload.future);
+            if (target != nullptr && ptr != nullptr) {
+                *target = std::move(*ptr);
+                ++count;
+            }
+        }
+        return count;
     }
 
 private:
+    /// \brief Resource being prefetched through \ref get_async
+    struct typed_prefetch_type final : prefetch_type
+    {
+        /// \brief Future for the resource
+        future_type future;
+
+        /// \brief Initializes a new instance of the
+        /// \ref typed_prefetch_type structure with the given future
+        /// \param f future for the resource
+        explicit typed_prefetch_type(future_type f)
+            : future{std::move(f)}
+        {
+        }
+
+        /// \brief Gets a value indicating whether the resource has been
+        /// created, or could not be
+        /// \return whether the prefetch is finished
+        bool is_ready() const override
+        {
+            return typed_resource_cache::is_ready(future);
+        }
+    };
+
+    /// \brief State of a resource name in the cache
+    struct entry_type
+    {
+        /// \brief Created resource, if any
+        std::weak_ptr<T> resource;
+
+        /// \brief Future for the resource while it is created
+        /// asynchronously, or while an asynchronous request waits for a
+        /// synchronous creation
+        future_type pending;
+
+        /// \brief Promise for \ref pending that the thread creating the
+        /// resource synchronously must satisfy
+        std::shared_ptr<std::promise<ptr_type>> promise;
+
+        /// \brief Whether a thread is creating the resource synchronously
+        bool is_creating{false};
+    };
+
+    /// \brief Resource held strongly by the retention policy
+    struct retained_type
+    {
+        name_type name; //!< Name of the resource
+        ptr_type resource; //!< Retained resource
+        std::size_t size; //!< Estimated size of the resource in bytes
+    };
+
+    /// \brief Resource being recreated by \ref reload
+    struct reload_type
+    {
+        std::weak_ptr<T> target; //!< Resource to replace the contents of
+        future_type future; //!< Future for the recreated resource
+    };
+
+    /// \brief Type of list of retained resources, most recently used first
+    using retained_list_type = std::list<retained_type>;
+
+    /// \brief Independently locked part of the cache
+    struct shard_type
+    {
+        std::mutex mutex; //!< Mutex guarding the entries
+
+        /// \brief Signalled when a synchronous creation finishes
+        std::condition_variable created;
+
+        /// \brief Entries by resource name
+        string_map<entry_type> entries;
+    };
+
+    /// \brief Gets the shard holding a name
+    /// \param name name of the resource
+    /// \return shard for \p name
+    shard_type& shard_for(string_key name) const
+    {
+        return _shards[name.hash() % shard_count];
+    }
+
+    /// \brief Finishes a synchronous creation, waking the threads waiting
+    /// for it
+    /// \param shard shard holding the entry
+    /// \param name name of the created resource
+    /// \param ptr pointer to the resource, or null if it was not created
+    /// \param error exception thrown by the creator, if any
+    static void finish(
+        shard_type& shard,
+        string_key name,
+        ptr_type const& ptr,
+        std::exception_ptr error)
+    {
+        std::shared_ptr<std::promise<ptr_type>> promise;
+        {
+            std::lock_guard<std::mutex> lock{shard.mutex};
+            auto& entry = *shard.entries.find(name);
+            entry.resource = ptr;
+            entry.is_creating = false;
+            promise = std::move(entry.promise);
+            if (promise != nullptr) {
+                entry.pending = {};
+            }
+        }
+        shard.created.notify_all();
+        if (promise == nullptr) {
+            return;
+        }
+        if (error != nullptr) {
+            promise->set_exception(error);
+        }
+        else {
+            promise->set_value(ptr);
+        }
+    }
+
+    /// \brief Marks a resource as the most recently used, retaining it if
+    /// the budget allows
+    /// \param name name of the resource
+    /// \param ptr pointer to the resource
+    ///
+    /// Must not be called with a shard locked.
+    void retain(string_key name, ptr_type const& ptr) const
+    {
+        if (ptr == nullptr || _retention_budget == 0) {
+            return;
+        }
+
+        size_estimator_type estimator;
+        {
+            std::lock_guard<std::mutex> lock{_retained_mutex};
+            auto iter = _retained_index.find(name);
+            if (iter != nullptr) {
+                _retained.splice(std::begin(_retained), _retained, *iter);
+                return;
+            }
+            estimator = _size_estimator;
+        }
+
+        // Estimating may be slow, so it is done without the lock held
+        auto owned_name = name.str();
+        auto size = estimator ? estimator(owned_name, *ptr) : sizeof(T);
+        std::vector<ptr_type> released;
+        std::lock_guard<std::mutex> lock{_retained_mutex};
+        if (size > _retention_budget
+            || _retained_index.find(name) != nullptr)
+        {
+            return;
+        }
+        _retained.push_front({std::move(owned_name), ptr, size});
+        _retained_index[name] = std::begin(_retained);
+        _retained_size += size;
+        evict(released);
+    }
+
+    /// \brief Releases the least recently used resources until the retained
+    /// size fits the budget
+    /// \param released where to move the released resources, so that they
+    /// are destroyed after the lock is released
+    ///
+    /// Must be called with \ref _retained_mutex locked.
+    void evict(std::vector<ptr_type>& released) const
+    {
+        while (!_retained.empty() && _retained_size > _retention_budget) {
+            auto& oldest = _retained.back();
+            _retained_size -= oldest.size;
+            _retained_index.erase(oldest.name);
+            released.emplace_back(std::move(oldest.resource));
+            _retained.pop_back();
+        }
+    }
+
+    /// \brief Gets a value indicating whether a future is ready
+    /// \param future future to check
+    /// \return whether \p future is ready
+    static bool is_ready(future_type const& future)
+    {
+        return future.wait_for(std::chrono::seconds{0})
+            == std::future_status::ready;
+    }
+
+    /// \brief Gets the resource of a future, waiting for it if necessary
+    /// \param future future to get
+    /// \return pointer to the resource, or null if it could not be created
+    static ptr_type get_ready(future_type const& future)
+    {
+        try {
+            return future.get();
+        }
+        catch (...) {
+            return nullptr;
+        }
+    }
+
     creator_type _creator; //!< Resource creation function
-    std::map<name_type, std::weak_ptr<T>> _resources; //!< Resource container
+
+    /// \brief Function starting the asynchronous creation of a resource,
+    /// or empty to call \ref _creator on the workers
+    async_creator_type _async_creator;
+
+    /// \brief Thread that finishes asynchronous creations, which never
+    /// waits for them
+    std::atomic<std::thread::id> _async_thread{std::thread::id{}};
+
+    /// \brief Function starting the asynchronous recreation of a resource,
+    /// or empty to call \ref _creator on the workers
+    async_creator_type _async_reloader;
+
+    /// \brief Resource containers, by hash of the name
+    mutable std::array<shard_type, shard_count> _shards;
+
+    /// \brief Mutex guarding the retained resources, never held together
+    /// with the mutex of a shard
+    mutable std::mutex _retained_mutex;
+
+    /// \brief Retained resources, most recently used first
+    mutable retained_list_type _retained;
+
+    /// \brief Iterators into \ref _retained by resource name
+    mutable string_map<typename retained_list_type::iterator>
+        _retained_index;
+
+    mutable std::size_t _retained_size{0}; //!< Size of retained resources
+    std::atomic<std::size_t> _retention_budget{0}; //!< Retention budget
+    size_estimator_type _size_estimator; //!< Resource size estimator
+
+    std::mutex _reloads_mutex; //!< Mutex guarding the reloads and reloader
+    std::vector<reload_type> _reloads; //!< Resources being recreated
 };
 
 /// \}
@@ -0,0 +1,67 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::resource_handle class interface
+/// \ingroup resource
+
+#pragma once
+
+#include "blip/string.hpp"
+#include "blip/string_key.hpp"
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Name of a resource with its hash computed once
+///
+/// A resource looked up repeatedly, such as every frame, can be named by a
+/// handle kept by the code using it, so that the name is neither copied nor
+/// hashed on each lookup. Handles are accepted wherever a
+/// \ref string_key is.
+class resource_handle
+{
+public:
+    /// \brief Initializes a new instance of the \ref resource_handle class
+    /// \param name name of the resource
+    resource_handle(std::string name)
+        : _name{std::move(name)}
+        , _hash{hash_string(_name.data(), _name.size())}
+    {
+    }
+
+    /// \brief Initializes a new instance of the \ref resource_handle class
+    /// \param name name of the resource
+    resource_handle(char const* name)
+        : resource_handle{std::string{name}}
+    {
+    }
+
+    /// \brief Gets the name of the resource
+    /// \return name
+    std::string const& name() const noexcept { return _name; }
+
+    /// \brief Gets the hash of the name
+    /// \return hash
+    std::size_t hash() const noexcept { return _hash; }
+
+    /// \brief Gets a key referring to the name and its hash
+    /// \return key, valid while the handle is
+    operator string_key() const noexcept
+    {
+        return {_name.data(), _name.size(), _hash};
+    }
+
+private:
+    std::string _name; //!< Name of the resource
+    std::size_t _hash; //!< Hash of the name
+};
+
+/// \}
+
+}
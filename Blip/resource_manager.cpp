@@ -6,7 +6,22 @@
 
 #include "blip/resource_manager.hpp"
 #include "blip/path.hpp"
+#include <pugixml.hpp>
 #include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+/// \brief Mutex guarding the slots of resource types
+std::mutex slots_mutex;
+
+/// \brief Slots of resource types, assigned in order of first use
+std::unordered_map<std::type_index, std::size_t> slots;
+
+}
 
 namespace blip {
 
@@ -15,35 +30,105 @@ std::string resource_manager::path_to(std::string const& path) const
     return join_path({base_path, path});
 }
 
+void resource_manager::archive(resource_archive archive)
+{
+    _archive = std::move(archive);
+}
+
+bool resource_manager::load_document(
+    std::string const& path,
+    pugi::xml_document& doc) const
+{
+    auto blob = _archive.find(path);
+    if (blob.data != nullptr) {
+        return doc.load_buffer(blob.data, blob.size);
+    }
+    return doc.load_file(path_to(path).c_str());
+}
+
+resource_prefetch resource_manager::prefetch(
+    resource_manifest const& manifest)
+{
+    resource_prefetch prefetch;
+    std::shared_lock<std::shared_timed_mutex> lock{_caches_mutex};
+    for (auto&& entry : manifest.entries) {
+        auto iter = _caches.find(entry.type);
+        if (iter != std::end(_caches)) {
+            prefetch.add(iter->second->prefetch(entry.name, _workers));
+        }
+    }
+    return prefetch;
+}
+
 void resource_manager::sweep()
 {
+    std::shared_lock<std::shared_timed_mutex> lock{_caches_mutex};
     for (auto&& pair : _caches) {
         pair.second->sweep();
     }
 }
 
+bool resource_manager::reload(
+    std::type_index const& type,
+    std::string const& name)
+{
+    std::shared_lock<std::shared_timed_mutex> lock{_caches_mutex};
+    auto iter = _caches.find(type);
+    if (iter == std::end(_caches)) {
+        return false;
+    }
+    return iter->second->reload(name, _workers);
+}
+
+std::size_t resource_manager::apply_reloads()
+{
+    std::size_t count{0};
+    std::shared_lock<std::shared_timed_mutex> lock{_caches_mutex};
+    for (auto&& pair : _caches) {
+        count += pair.second->apply_reloads();
+    }
+    return count;
+}
+
 bool resource_manager::has_cache(std::type_index const& type) const
 {
+    std::shared_lock<std::shared_timed_mutex> lock{_caches_mutex};
     return _caches.find(type) != std::end(_caches);
 }
 
 bool resource_manager::add_cache(pair_type&& pair)
 {
-    return _caches.emplace(std::move(pair)).second;
+    if (pair.second == nullptr || pair.second->type() != pair.first) {
+        throw std::invalid_argument{"cache does not match its type"};
+    }
+    auto slot = slot_of(pair.first);
+    std::lock_guard<std::shared_timed_mutex> lock{_caches_mutex};
+    auto result = _caches.emplace(std::move(pair));
+    if (result.second && slot < slot_count) {
+        _slots[slot].store(result.first->second.get(),
+            std::memory_order_release);
+    }
+    return result.second;
 }
 
 bool resource_manager::remove_cache(std::type_index const& type)
 {
+    std::lock_guard<std::shared_timed_mutex> lock{_caches_mutex};
     auto iter = _caches.find(type);
     if (iter == std::end(_caches)) {
         return false;
     }
+    auto slot = slot_of(type);
+    if (slot < slot_count) {
+        _slots[slot].store(nullptr, std::memory_order_release);
+    }
     _caches.erase(iter);
     return true;
 }
 
 resource_cache* resource_manager::cache_for(std::type_index const& type) const
 {
+    std::shared_lock<std::shared_timed_mutex> lock{_caches_mutex};
     auto iter = _caches.find(type);
     if (iter == std::end(_caches)) {
         return nullptr;
@@ -51,4 +136,10 @@ resource_cache* resource_manager::cache_for(std::type_index const& type) const
     return iter->second.get();
 }
 
+std::size_t resource_manager::slot_of(std::type_index const& type)
+{
+    std::lock_guard<std::mutex> lock{slots_mutex};
+    return slots.emplace(type, slots.size()).first->second;
+}
+
 }
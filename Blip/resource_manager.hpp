@@ -6,19 +6,44 @@
 
 #pragma once
 
+#include "resource_archive.hpp"
 #include "resource_cache.hpp"
+#include "resource_manifest.hpp"
+#include "string_key.hpp"
+#include "worker_pool.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <typeindex>
 #include <utility>
 
+namespace pugi {
+
+// Forward declarations
+class xml_document;
+
+}
+
 namespace blip {
 
 /// \addtogroup resource
 /// \{
 
 /// \brief Manager for several \ref resource_cache instances
+///
+/// Caches may be looked up from any number of threads at once, and added
+/// concurrently with lookups. A cache must not be removed while another
+/// thread may be using it.
+///
+/// Each resource type is given a slot the first time it is used with any
+/// manager, and the caches of the first \ref slot_count types are also
+/// indexed by slot. Looking up the cache for a type given at compile time
+/// is then a single load, without locking or RTTI.
 class resource_manager
 {
 public:
@@ -34,6 +59,9 @@ public:
     /// \brief Type of pairs mapping types and caches
     using pair_type = map_type::value_type;
 
+    /// \brief Number of resource types whose caches are indexed by slot
+    static constexpr std::size_t slot_count = 32;
+
     /// \brief Base resource path
     std::string base_path;
 
@@ -56,9 +84,49 @@ public:
     /// \return full resource path
     std::string path_to(std::string const& path) const;
 
+    /// \brief Gets the archive resources are loaded from
+    /// \return resource archive, which has no files if none was set
+    resource_archive const& archive() const noexcept { return _archive; }
+
+    /// \brief Sets the archive resources are loaded from
+    /// \param archive resource archive
+    ///
+    /// Must be set before any resource is loaded from the previous archive,
+    /// as resources may refer to its contents in place.
+    void archive(resource_archive archive);
+
+    /// \brief Loads an XML document from the archive, or from its loose
+    /// file if it is not packed
+    /// \param path resource path
+    /// \param doc document to load into
+    /// \return whether the document was loaded
+    bool load_document(std::string const& path, pugi::xml_document& doc)
+        const;
+
+    /// \brief Starts creating the resources of a manifest on the manager's
+    /// worker pool
+    /// \param manifest resources to create
+    /// \return prefetch holding the resources
+    ///
+    /// Resources of types without a cache are skipped.
+    resource_prefetch prefetch(resource_manifest const& manifest);
+
     /// \brief Sweeps the caches, removing expired resources
     void sweep();
 
+    /// \brief Starts reloading a resource in use on the manager's worker
+    /// pool
+    /// \param type type of resource
+    /// \param name name of the resource
+    /// \return whether the resource is being reloaded
+    /// \see typed_resource_cache::reload
+    bool reload(std::type_index const& type, std::string const& name);
+
+    /// \brief Replaces the contents of resources that have been reloaded
+    /// \return number of resources replaced
+    /// \see typed_resource_cache::apply_reloads
+    std::size_t apply_reloads();
+
     /// \brief Gets a value indicating whether the manager contains a cache
     /// for the given resource type
     /// \param type type of resource
@@ -68,6 +136,10 @@ public:
     /// \brief Adds a cache to the manager
     /// \param pair type-cache pair to add
     /// \return whether the cache was added
+    ///
+    /// Throws \ref std::invalid_argument if the cache is null or holds
+    /// resources of another type, as caches are looked up by type without
+    /// checking their own type.
     bool add_cache(pair_type&& pair);
 
     /// \brief Removes a cache from the manager
@@ -80,6 +152,23 @@ public:
     /// \return pointer to the cache
     resource_cache* cache_for(std::type_index const& type) const;
 
+    /// \brief Gets the slot of a resource type, assigning one if it has
+    /// none
+    /// \param type type of resource
+    /// \return slot of the type
+    static std::size_t slot_of(std::type_index const& type);
+
+    /// \brief Gets the slot of a resource type, assigning one if it has
+    /// none
+    /// \tparam T type of resource
+    /// \return slot of the type
+    template <typename T>
+    static std::size_t slot_of()
+    {
+        static auto const slot = slot_of(typeid(T));
+        return slot;
+    }
+
     /// \brief Gets a value indicating whether the manager contains a cache
     /// for the given resource type
     /// \tparam T type of resource
@@ -87,7 +176,7 @@ public:
     template <typename T>
     bool has_cache() const
     {
-        return has_cache(typeid(T));
+        return cache_for<T>() != nullptr;
     }
 
     /// \brief Adds a cache to the manager
@@ -109,13 +198,29 @@ public:
         return remove_cache(typeid(T));
     }
 
+    /// \brief Starts reloading a resource in use on the manager's worker
+    /// pool
+    /// \tparam T type of resource
+    /// \param name name of the resource
+    /// \return whether the resource is being reloaded
+    template <typename T>
+    bool reload(typename typed_resource_cache<T>::name_type const& name)
+    {
+        return reload(typeid(T), name);
+    }
+
     /// \brief Gets the cache for the given type
     /// \tparam T type of resource
     /// \return pointer to the cache
     template <typename T>
     typed_resource_cache<T>* cache_for() const
     {
-        return dynamic_cast<typed_resource_cache<T>*>(cache_for(typeid(T)));
+        // add_cache only accepts a typed cache of the type it is added for
+        auto slot = slot_of<T>();
+        auto cache = slot < slot_count
+            ? _slots[slot].load(std::memory_order_acquire)
+            : cache_for(typeid(T));
+        return static_cast<typed_resource_cache<T>*>(cache);
     }
 
     /// \brief Gets an existing resource from a cache by name
@@ -123,8 +228,7 @@ public:
     /// \param name name of the resource
     /// \return pointer to the resource
     template <typename T>
-    typename typed_resource_cache<T>::ptr_type get(
-        typename typed_resource_cache<T>::name_type const& name) const
+    typename typed_resource_cache<T>::ptr_type get(string_key name) const
     {
         auto cache = cache_for<T>();
         if (cache == nullptr) {
@@ -138,8 +242,7 @@ public:
     /// \param name name of the resource
     /// \return pointer to the resource
     template <typename T>
-    typename typed_resource_cache<T>::ptr_type get(
-        typename typed_resource_cache<T>::name_type const& name)
+    typename typed_resource_cache<T>::ptr_type get(string_key name)
     {
         auto cache = cache_for<T>();
         if (cache == nullptr) {
@@ -148,8 +251,51 @@ public:
         return cache->get(name);
     }
 
+    /// \brief Gets a resource from a cache by name, creating it on the
+    /// manager's worker pool
+    /// \tparam T type of resource
+    /// \param name name of the resource
+    /// \return future for the pointer to the resource
+    /// \see typed_resource_cache::get_async
+    template <typename T>
+    typename typed_resource_cache<T>::future_type get_async(
+        string_key name)
+    {
+        auto cache = cache_for<T>();
+        if (cache == nullptr) {
+            std::promise<typename typed_resource_cache<T>::ptr_type> promise;
+            promise.set_value(nullptr);
+            return promise.get_future().share();
+        }
+        return cache->get_async(name, _workers);
+    }
+
+    /// \brief Gets the pool resources are created on asynchronously
+    /// \return worker pool
+    worker_pool& workers() noexcept { return _workers; }
+
 private:
+    /// \brief Archive resources are loaded from
+    ///
+    /// Declared before the caches so that resources referring to its
+    /// contents are destroyed first.
+    resource_archive _archive;
+
     map_type _caches; //!< Cache container
+
+    /// \brief Caches by the slots of their types, or null where there is
+    /// no cache
+    std::array<std::atomic<resource_cache*>, slot_count> _slots{};
+
+    /// \brief Mutex guarding the cache container, locked exclusively only
+    /// to add or remove caches
+    mutable std::shared_timed_mutex _caches_mutex;
+
+    /// \brief Pool resources are created on asynchronously
+    ///
+    /// Declared after the caches so that the workers are stopped before the
+    /// caches are destroyed.
+    worker_pool _workers;
 };
 
 /// \}
@@ -0,0 +1,106 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::resource_manifest structure and
+/// \ref blip::resource_prefetch class implementations
+/// \ingroup resource
+
+#include "blip/resource_manifest.hpp"
+#include "blip/xml_deserializer.hpp"
+#include "blip/xml_serializer.hpp"
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+namespace {
+
+/// \brief Type of pair mapping resource types to their names
+using type_name_pair = std::pair<std::type_index, char const*>;
+
+/// \brief Gets the names of the resource types listed in manifests
+/// \return pairs of resource types and names
+std::array<type_name_pair, 4> const& type_names()
+{
+    static std::array<type_name_pair, 4> const names{{
+        {typeid(sf::Font), "Font"},
+        {typeid(sf::Image), "Image"},
+        {typeid(sf::SoundBuffer), "SoundBuffer"},
+        {typeid(sf::Texture), "Texture"},
+    }};
+    return names;
+}
+
+}
+
+namespace blip {
+
+bool resource_prefetch::is_ready() const
+{
+    // Prefetches finish in roughly the order they were started, so the
+    // leading ready ones are not checked again
+    while (_ready_count < _resources.size()
+        && _resources[_ready_count]->is_ready())
+    {
+        ++_ready_count;
+    }
+    return _ready_count == _resources.size();
+}
+
+void resource_prefetch::add(pointer_type ptr)
+{
+    _resources.emplace_back(std::move(ptr));
+}
+
+bool xml_converter<resource_manifest>::deserialize(
+    xml_deserializer& dx,
+    resource_manifest& t)
+{
+    for (auto&& child : dx.node.children("Resource")) {
+        xml_deserializer cx{child};
+        std::string type_name;
+        std::string name;
+        if (!cx.attribute("Type", type_name) || !cx.attribute("Name", name)) {
+            return false;
+        }
+
+        auto&& names = type_names();
+        auto iter = std::find_if(std::begin(names), std::end(names),
+            [&type_name](type_name_pair const& pair)
+            {
+                return type_name == pair.second;
+            });
+        if (iter == std::end(names)) {
+            return false;
+        }
+        t.entries.push_back({iter->first, std::move(name)});
+    }
+    return true;
+}
+
+bool xml_converter<resource_manifest>::serialize(
+    xml_serializer& sx,
+    resource_manifest const& t)
+{
+    auto&& names = type_names();
+    for (auto&& entry : t.entries) {
+        auto iter = std::find_if(std::begin(names), std::end(names),
+            [&entry](type_name_pair const& pair)
+            {
+                return entry.type == pair.first;
+            });
+        if (iter == std::end(names)) {
+            return false;
+        }
+        auto cx = sx.child("Resource");
+        cx.attribute("Type", iter->second);
+        cx.attribute("Name", entry.name);
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,108 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::resource_manifest structure and
+/// \ref blip::resource_prefetch class interfaces
+/// \ingroup resource
+
+#pragma once
+
+#include "blip/resource_cache.hpp"
+#include "blip/xml_converter.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief List of resources that are needed together, such as by a state,
+/// so that they can be prefetched before they are used
+struct resource_manifest
+{
+    /// \brief Resource listed in a manifest
+    struct entry_type
+    {
+        std::type_index type; //!< Type of the resource
+        std::string name; //!< Name of the resource
+    };
+
+    /// \brief Listed resources
+    std::vector<entry_type> entries;
+
+    /// \brief Adds a resource to the manifest
+    /// \tparam T type of resource
+    /// \param name name of the resource
+    template <typename T>
+    void add(std::string name)
+    {
+        entries.push_back({typeid(T), std::move(name)});
+    }
+};
+
+/// \brief Resources of a \ref resource_manifest being loaded, which are held
+/// until the prefetch is destroyed
+class resource_prefetch
+{
+public:
+    /// \brief Type of owning pointer for the prefetch of a single resource
+    using pointer_type = std::unique_ptr<resource_cache::prefetch_type>;
+
+    /// \brief Gets the number of resources being prefetched
+    /// \return number of resources
+    std::size_t size() const noexcept { return _resources.size(); }
+
+    /// \brief Gets a value indicating whether every resource has been
+    /// created, or could not be
+    /// \return whether the prefetch is finished
+    bool is_ready() const;
+
+    /// \brief Adds the prefetch of a resource
+    /// \param ptr prefetch of the resource
+    void add(pointer_type ptr);
+
+private:
+    /// \brief Prefetches of the resources
+    std::vector<pointer_type> _resources;
+
+    /// \brief Number of leading resources known to be ready
+    mutable std::size_t _ready_count{0};
+};
+
+/// \}
+
+/// \addtogroup xml
+/// \{
+
+/// \brief Specifies XML conversion functions for \ref resource_manifest
+///
+/// Each resource is a \c Resource child with \c Type and \c Name
+/// attributes. The types are \c Font, \c Image, \c SoundBuffer, and
+/// \c Texture.
+template <>
+struct xml_converter<resource_manifest>
+{
+    /// \brief Deserializes a \ref resource_manifest from a
+    /// \ref xml_deserializer
+    /// \param dx deserializer to input from
+    /// \param t manifest to input
+    /// \return whether the deserialization was successful
+    static bool deserialize(xml_deserializer& dx, resource_manifest& t);
+
+    /// \brief Serializes a \ref resource_manifest to a \ref xml_serializer
+    /// \param sx serializer to output to
+    /// \param t manifest to output
+    /// \return whether the serialization was successful
+    static bool serialize(xml_serializer& sx, resource_manifest const& t);
+};
+
+/// \}
+
+}
@@ -0,0 +1,40 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the resource size estimation function definitions
+/// \ingroup resource
+
+#include "blip/resource_size.hpp"
+#include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace {
+
+/// \brief Number of bytes in each pixel of images and textures
+constexpr std::size_t bytes_per_pixel = 4;
+
+}
+
+namespace blip {
+
+std::size_t resource_size(sf::Image const& image)
+{
+    auto size = image.getSize();
+    return std::size_t{size.x} * size.y * bytes_per_pixel;
+}
+
+std::size_t resource_size(sf::SoundBuffer const& buffer)
+{
+    return static_cast<std::size_t>(buffer.getSampleCount())
+        * sizeof(sf::Int16);
+}
+
+std::size_t resource_size(sf::Texture const& texture)
+{
+    auto size = texture.getSize();
+    return std::size_t{size.x} * size.y * bytes_per_pixel;
+}
+
+}
@@ -0,0 +1,45 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the resource size estimation functions
+/// \ingroup resource
+
+#pragma once
+
+#include <cstddef>
+
+namespace sf {
+
+// Forward declarations
+class Image;
+class SoundBuffer;
+class Texture;
+
+}
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Estimates the memory used by an image
+/// \param image image to estimate
+/// \return size of the pixel data in bytes
+std::size_t resource_size(sf::Image const& image);
+
+/// \brief Estimates the memory used by a sound buffer
+/// \param buffer sound buffer to estimate
+/// \return size of the sample data in bytes
+std::size_t resource_size(sf::SoundBuffer const& buffer);
+
+/// \brief Estimates the graphics memory used by a texture
+/// \param texture texture to estimate
+/// \return size of the pixel data in bytes
+///
+/// Textures are assumed to be stored with four bytes per pixel.
+std::size_t resource_size(sf::Texture const& texture);
+
+/// \}
+
+}
@@ -40,6 +40,10 @@ bool does_block_draw(state_type type)
     }
 }
 
+void state::interpolate(float)
+{
+}
+
 void state::focus()
 {
     if (!_is_focused) {
@@ -8,8 +8,10 @@
 #pragma once
 
 #include "blip/notifiable.hpp"
+#include "blip/resource_manifest.hpp"
 #include "blip/updatable.hpp"
 #include <SFML/Graphics/Drawable.hpp>
+#include <utility>
 
 namespace blip {
 
@@ -84,12 +86,61 @@ public:
     /// \see show
     void hide();
 
+    /// \brief Gets a value indicating whether the state must be notified of
+    /// every joystick move
+    /// \return whether the state needs every sample
+    ///
+    /// Unless a focused state needs every sample, the joystick moves of
+    /// each frame are coalesced so that only the latest position of each
+    /// axis is notified.
+    bool needs_every_sample() const noexcept { return _needs_every_sample; }
+
+    /// \brief Gets the resources the state needs
+    /// \return resource manifest
+    ///
+    /// The resources are prefetched when the state is pushed, and the state
+    /// is not pushed until they are ready.
+    resource_manifest const& manifest() const noexcept { return _manifest; }
+
+    /// \brief Holds prefetched resources for the lifetime of the state
+    /// \param prefetch prefetch of the resources in \ref manifest
+    void hold(resource_prefetch prefetch) noexcept
+    {
+        _prefetch = std::move(prefetch);
+    }
+
+    /// \brief Prepares the state to be drawn between two updates
+    /// \param alpha fraction of a fixed time step elapsed since the last
+    /// update, on [0,1]
+    ///
+    /// When the application runs with a fixed time step, this is called
+    /// before each draw so that the state can blend its previous and current
+    /// simulation values. Otherwise, \p alpha is always 1.
+    virtual void interpolate(float alpha);
+
 protected:
     /// \brief Initializes a new instance of the \ref state class with the
     /// given type
     /// \param t type of state
     explicit state(state_type t) : type{t} {}
 
+    /// \brief Sets whether the state must be notified of every joystick
+    /// move
+    /// \param value whether the state needs every sample
+    void needs_every_sample(bool value) noexcept
+    {
+        _needs_every_sample = value;
+    }
+
+    /// \brief Sets the resources the state needs
+    /// \param manifest resource manifest
+    ///
+    /// Must be set by the constructor of the state to be prefetched.
+    void manifest(resource_manifest manifest) noexcept
+    {
+        _manifest = std::move(manifest);
+    }
+
     /// \brief Responds to the state becoming focused
     /// \see is_focused
     /// \see focus
@@ -124,6 +175,12 @@ private:
     bool _is_focused{false}; //!< Whether the state is focused
     bool _is_enabled{false}; //!< Whether the state is enabled
     bool _is_visible{false}; //!< Whether the state is visible
+
+    /// \brief Whether the state must be notified of every joystick move
+    bool _needs_every_sample{false};
+
+    resource_manifest _manifest; //!< Resources the state needs
+    resource_prefetch _prefetch; //!< Prefetched resources held by the state
 };
 
 /// \brief Determines whether a state of the given type will block notify
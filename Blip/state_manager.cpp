@@ -7,18 +7,23 @@
 
 #include "blip/state_manager.hpp"
 #include "blip/iterator.hpp"
+#include "blip/resource_manager.hpp"
+#include "blip/trace.hpp"
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <typeinfo>
 
 namespace blip {
 
 bool state_manager::push_front(pointer_type&& ptr)
 {
-    return try_job<push_front_job>(std::move(ptr));
+    auto pf = prefetch(*ptr);
+    return try_job<push_front_job>(std::move(ptr), std::move(pf));
 }
 
 bool state_manager::push_back(pointer_type&& ptr)
 {
-    return try_job<push_back_job>(std::move(ptr));
+    auto pf = prefetch(*ptr);
+    return try_job<push_back_job>(std::move(ptr), std::move(pf));
 }
 
 bool state_manager::pop_front()
@@ -64,17 +69,22 @@ bool state_manager::work()
     }
 
     std::lock_guard<mutex_type> lock{mutex, std::adopt_lock_t{}};
-    while (!_jobs.empty()) {
+    trace_scope trace{"State jobs"};
+    auto did_work = false;
+    while (!_jobs.empty() && _jobs.front()->is_ready()) {
         _jobs.front()->apply(*this);
         _jobs.pop();
+        did_work = true;
     }
-    return true;
+    return did_work;
 }
 
 bool state_manager::notify(const sf::Event& event)
 {
     for (auto&& p : reverse(_list)) {
         if (p->is_focused()) {
+            trace_scope trace{typeid(*p).name()};
+            profile_scope scope{_profiler, typeid(*p), profile_phase::notify};
             if (p->notify(event)) {
                 return true;
             }
@@ -83,25 +93,57 @@ bool state_manager::notify(const sf::Event& event)
     return false;
 }
 
+bool state_manager::needs_every_sample() const
+{
+    for (auto&& p : _list) {
+        if (p->is_focused() && p->needs_every_sample()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void state_manager::update(float time_step)
 {
     for (auto&& p : reverse(_list)) {
         if (p->is_enabled()) {
+            trace_scope trace{typeid(*p).name()};
+            profile_scope scope{_profiler, typeid(*p), profile_phase::update};
             p->update(time_step);
         }
     }
 }
 
+void state_manager::interpolate(float alpha)
+{
+    for (auto&& p : _list) {
+        if (p->is_visible()) {
+            p->interpolate(alpha);
+        }
+    }
+}
+
 void state_manager::draw(sf::RenderTarget& target, sf::RenderStates states)
     const
 {
     for (auto&& p : _list) {
         if (p->is_visible()) {
+            trace_scope trace{typeid(*p).name()};
+            profile_scope scope{_profiler, typeid(*p), profile_phase::draw};
             target.draw(*p, states);
         }
     }
 }
 
+resource_prefetch state_manager::prefetch(state const& s)
+{
+    if (_resources == nullptr || s.manifest().entries.empty()) {
+        return {};
+    }
+    trace_scope trace{"Prefetch state resources"};
+    return _resources->prefetch(s.manifest());
+}
+
 // Explicit vtable for purely virtual class
 state_manager::job::~job() = default;
 
@@ -138,6 +180,7 @@ void state_manager::push_front_job::apply(state_manager& mgr)
         ptr->show();
     }
 
+    ptr->hold(std::move(prefetch));
     mgr._list.emplace_front(std::move(ptr));
 }
 
@@ -165,6 +208,7 @@ void state_manager::push_back_job::apply(state_manager& mgr)
         }
     }
 
+    ptr->hold(std::move(prefetch));
     mgr._list.emplace_back(std::move(ptr));
 }
 
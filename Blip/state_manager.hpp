@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include "blip/frame_profiler.hpp"
 #include "blip/notifiable.hpp"
+#include "blip/resource_manifest.hpp"
 #include "blip/state.hpp"
 #include "blip/updatable.hpp"
 #include <SFML/Graphics/Drawable.hpp>
@@ -20,10 +22,18 @@
 
 namespace blip {
 
+// Forward declarations
+class resource_manager;
+
 /// \addtogroup state
 /// \{
 
 /// \brief Manager for several \ref state instances
+///
+/// Changes are applied in the order they are made. A pushed state whose
+/// \ref state::manifest lists resources waits in the job queue, along with
+/// every later change, until its resources have been prefetched, so that
+/// it does not stall on loading them once it is running.
 class state_manager : public notifiable, public updatable, public sf::Drawable
 {
 public:
@@ -39,6 +49,26 @@ public:
     /// \brief Mutex for using the state list
     mutex_type mutex;
 
+    /// \brief Gets the profiler that per-state timings are recorded with
+    /// \return pointer to the profiler, or null if timings are not recorded
+    frame_profiler* profiler() const noexcept { return _profiler; }
+
+    /// \brief Sets the profiler that per-state timings are recorded with
+    /// \param p pointer to the profiler, or null to record no timings
+    void profiler(frame_profiler* p) noexcept { _profiler = p; }
+
+    /// \brief Gets the resource manager that state manifests are prefetched
+    /// from
+    /// \return pointer to the resource manager, or null if resources are not
+    /// prefetched
+    resource_manager* resources() const noexcept { return _resources; }
+
+    /// \brief Sets the resource manager that state manifests are prefetched
+    /// from
+    /// \param r pointer to the resource manager, or null to prefetch no
+    /// resources
+    void resources(resource_manager* r) noexcept { _resources = r; }
+
     /// \brief Pushes a state onto the front of the state list
     /// \param ptr pointer to the state to push
     /// \return whether the change was applied immediately
@@ -83,7 +113,8 @@ public:
     /// \return whether work was done
     ///
     /// If this method returns false, either the state list could not be
-    /// locked or the job queue was empty.
+    /// locked, the job queue was empty, or the first job is a push waiting
+    /// for its resources.
     bool work();
 
     /// \brief Notifies the focused states of an event
@@ -93,12 +124,24 @@ public:
     /// The notification is propagated from back to front until interception.
     bool notify(const sf::Event& event) override;
 
+    /// \brief Gets a value indicating whether any focused state must be
+    /// notified of every joystick move
+    /// \return whether every sample is needed
+    /// \see state::needs_every_sample
+    bool needs_every_sample() const;
+
     /// \brief Updates the enabled states by a time step
     /// \param time_step time step to update by
     ///
     /// The update is propagated from back to front.
     void update(float time_step) override;
 
+    /// \brief Prepares the visible states to be drawn between two updates
+    /// \param alpha fraction of a fixed time step elapsed since the last
+    /// update, on [0,1]
+    /// \see state::interpolate
+    void interpolate(float alpha);
+
 protected:
     /// \brief Draws the visible states to the given render target
     /// \param target render target to draw to
@@ -115,6 +158,10 @@ private:
         /// \brief Destructs the \ref job instance
         virtual ~job();
 
+        /// \brief Gets a value indicating whether the job can be applied
+        /// \return whether the job is ready
+        virtual bool is_ready() const { return true; }
+
         /// \brief Applies the job to the given state manager
         /// \param mgr manager to apply the job to
         virtual void apply(state_manager& mgr) = 0;
@@ -126,14 +173,24 @@ private:
         /// \brief Pointer to push
         pointer_type ptr;
 
+        /// \brief Prefetch of the resources the pushed state needs
+        resource_prefetch prefetch;
+
         /// \brief Initializes a new instance of the \ref push_front_job
         /// structure with the given pointer to push
         /// \param p pointer to push
-        explicit push_front_job(pointer_type&& p)
+        /// \param pf prefetch of the resources the pushed state needs
+        push_front_job(pointer_type&& p, resource_prefetch&& pf)
             : ptr{std::move(p)}
+            , prefetch{std::move(pf)}
         {
         }
 
+        /// \brief Gets a value indicating whether the resources have been
+        /// prefetched
+        /// \return whether the job is ready
+        bool is_ready() const override { return prefetch.is_ready(); }
+
         /// \brief Applies the job to the given state manager
         /// \param mgr manager to apply the job to
         void apply(state_manager& mgr) override;
@@ -145,14 +202,24 @@ private:
         /// \brief Pointer to push
         pointer_type ptr;
 
+        /// \brief Prefetch of the resources the pushed state needs
+        resource_prefetch prefetch;
+
         /// \brief Initializes a new instance of the \ref push_back_job
         /// structure with the given pointer to push
         /// \param p pointer to push
-        explicit push_back_job(pointer_type&& p)
+        /// \param pf prefetch of the resources the pushed state needs
+        push_back_job(pointer_type&& p, resource_prefetch&& pf)
             : ptr{std::move(p)}
+            , prefetch{std::move(pf)}
         {
         }
 
+        /// \brief Gets a value indicating whether the resources have been
+        /// prefetched
+        /// \return whether the job is ready
+        bool is_ready() const override { return prefetch.is_ready(); }
+
         /// \brief Applies the job to the given state manager
         /// \param mgr manager to apply the job to
         void apply(state_manager& mgr) override;
@@ -184,6 +251,15 @@ private:
 
     std::queue<std::unique_ptr<job>> _jobs; //!< Queue of pending jobs
     container_type _list; //!< List of managed states
+    frame_profiler* _profiler{nullptr}; //!< Profiler for per-state timings
+
+    /// \brief Resource manager state manifests are prefetched from
+    resource_manager* _resources{nullptr};
+
+    /// \brief Starts prefetching the resources a state needs
+    /// \param s state to prefetch for
+    /// \return prefetch of the resources
+    resource_prefetch prefetch(state const& s);
 
     /// \brief Tries to perform a job
     /// \tparam Job type of job to perform
@@ -191,20 +267,20 @@ private:
     /// \param args arguments for the job
     /// \return whether the change was applied immediately
     ///
-    /// If the change could not be applied immediately, it will be placed on
-    /// the job queue.
+    /// If the change could not be applied immediately, because the job is
+    /// not ready, another job is queued before it, or the state list is
+    /// locked, it will be placed on the job queue.
     template <typename Job, typename... Args>
     bool try_job(Args&&... args)
     {
-        if (mutex.try_lock()) {
+        Job job{std::forward<Args>(args)...};
+        if (_jobs.empty() && job.is_ready() && mutex.try_lock()) {
             std::lock_guard<mutex_type> lock{mutex, std::adopt_lock_t{}};
-            Job job{std::forward<Args>(args)...};
             job.apply(*this);
             return true;
         }
 
-        _jobs.emplace(
-            std::make_unique<Job>(std::forward<Args>(args)...));
+        _jobs.emplace(std::make_unique<Job>(std::move(job)));
         return false;
     }
 };
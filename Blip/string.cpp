@@ -7,8 +7,36 @@
 
 #include "blip/string.hpp"
 #include <codecvt>
+#include <cstdint>
 #include <locale>
 
+namespace {
+
+/// \brief Parameters of the FNV-1a hash for the width of a hash
+/// \tparam Size size of the hash in bytes
+template <std::size_t Size>
+struct fnv_parameters;
+
+/// \brief Parameters of the 32-bit FNV-1a hash
+template <>
+struct fnv_parameters<4>
+{
+    /// \brief Offset basis
+    static constexpr std::uint32_t offset_basis = 2166136261u;
+    static constexpr std::uint32_t prime = 16777619u; //!< Prime
+};
+
+/// \brief Parameters of the 64-bit FNV-1a hash
+template <>
+struct fnv_parameters<8>
+{
+    /// \brief Offset basis
+    static constexpr std::uint64_t offset_basis = 14695981039346656037u;
+    static constexpr std::uint64_t prime = 1099511628211u; //!< Prime
+};
+
+}
+
 namespace blip {
 
 std::string narrow(std::wstring const& str)
@@ -23,4 +51,25 @@ std::wstring widen(std::string const& str)
     return cvt.from_bytes(str);
 }
 
+std::size_t hash_string(char const* str, std::size_t size) noexcept
+{
+    using parameters = fnv_parameters<sizeof(std::size_t)>;
+    std::size_t hash = parameters::offset_basis;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= parameters::prime;
+    }
+    return hash;
+}
+
+bool parse_option(std::string const& arg, char const* name, std::string& value)
+{
+    auto prefix = std::string{name} + '=';
+    if (arg.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = arg.substr(prefix.size());
+    return true;
+}
+
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace blip {
@@ -24,6 +25,25 @@ std::string narrow(std::wstring const& str);
 /// \return \p str in wide-character
 std::wstring widen(std::string const& str);
 
+/// \brief Computes the hash of a string
+/// \param str pointer to the characters of the string
+/// \param size number of characters
+/// \return hash of the string
+///
+/// Unlike \ref std::hash, the string need not be held in a
+/// \ref std::string, so that it can be hashed without being copied.
+std::size_t hash_string(char const* str, std::size_t size) noexcept;
+
+/// \brief Gets the value of a command line option of the form name=value
+/// \param arg command line argument
+/// \param name name of the option, including its leading dashes
+/// \param value value of the option
+/// \return whether \p arg is the option
+bool parse_option(
+    std::string const& arg,
+    char const* name,
+    std::string& value);
+
 /// \}
 
 }
@@ -0,0 +1,99 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::string_key class interface
+/// \ingroup string
+
+#pragma once
+
+#include "blip/string.hpp"
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace blip {
+
+/// \addtogroup string
+/// \{
+
+/// \brief Reference to a string and its hash, for looking strings up
+/// without copying or hashing them again
+///
+/// A key refers to characters it does not own, so it must not outlive the
+/// string it was made from. It is meant to be passed by value to lookups.
+class string_key
+{
+public:
+    /// \brief Initializes a new instance of the \ref string_key class
+    /// referring to a null-terminated string
+    /// \param str null-terminated string
+    string_key(char const* str) noexcept
+        : string_key{str, std::strlen(str)}
+    {
+    }
+
+    /// \brief Initializes a new instance of the \ref string_key class
+    /// referring to a string
+    /// \param str string
+    string_key(std::string const& str) noexcept
+        : string_key{str.data(), str.size()}
+    {
+    }
+
+    /// \brief Initializes a new instance of the \ref string_key class
+    /// referring to characters
+    /// \param str pointer to the characters
+    /// \param size number of characters
+    string_key(char const* str, std::size_t size) noexcept
+        : string_key{str, size, hash_string(str, size)}
+    {
+    }
+
+    /// \brief Initializes a new instance of the \ref string_key class
+    /// referring to characters whose hash is known
+    /// \param str pointer to the characters
+    /// \param size number of characters
+    /// \param hash hash of the characters, as given by \ref hash_string
+    string_key(char const* str, std::size_t size, std::size_t hash) noexcept
+        : _data{str}
+        , _size{size}
+        , _hash{hash}
+    {
+    }
+
+    /// \brief Gets the characters of the string
+    /// \return pointer to the characters, which are not null-terminated
+    char const* data() const noexcept { return _data; }
+
+    /// \brief Gets the number of characters in the string
+    /// \return number of characters
+    std::size_t size() const noexcept { return _size; }
+
+    /// \brief Gets the hash of the string
+    /// \return hash
+    std::size_t hash() const noexcept { return _hash; }
+
+    /// \brief Copies the string
+    /// \return copy of the string
+    std::string str() const { return {_data, _size}; }
+
+    /// \brief Gets a value indicating whether the key refers to the same
+    /// characters as a string
+    /// \param str string to compare to
+    /// \return whether the characters are equal
+    bool equals(std::string const& str) const noexcept
+    {
+        return str.size() == _size
+            && std::memcmp(str.data(), _data, _size) == 0;
+    }
+
+private:
+    char const* _data; //!< Characters of the string
+    std::size_t _size; //!< Number of characters
+    std::size_t _hash; //!< Hash of the characters
+};
+
+/// \}
+
+}
@@ -0,0 +1,268 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::string_map class interface
+/// \ingroup string
+
+#pragma once
+
+#include "blip/string_key.hpp"
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup string
+/// \{
+
+/// \brief Hash map from strings to values, looked up by \ref string_key
+/// \tparam V type of value, which must be default constructible and move
+/// assignable
+///
+/// Entries are stored in a single array with open addressing and linear
+/// probing, alongside the hashes of their keys, so that a lookup usually
+/// touches one cache line and compares characters only when the hashes are
+/// equal. Lookups by a key that is not held in a \ref std::string, or whose
+/// hash is already known, neither copy nor hash it.
+///
+/// Erased entries are not marked but filled by shifting back the entries
+/// after them, so probe lengths do not grow as entries come and go.
+/// Pointers and references to values are invalidated by any insertion or
+/// erasure.
+template <typename V>
+class string_map
+{
+public:
+    /// \brief Type of key held in the map
+    using key_type = std::string;
+
+    /// \brief Type of value held in the map
+    using mapped_type = V;
+
+    /// \brief Gets the number of entries
+    /// \return number of entries
+    std::size_t size() const noexcept { return _size; }
+
+    /// \brief Gets a value indicating whether the map has no entries
+    /// \return whether the map is empty
+    bool empty() const noexcept { return _size == 0; }
+
+    /// \brief Finds a value by key
+    /// \param key key of the value
+    /// \return pointer to the value, or null if the map has no such key
+    V* find(string_key key) noexcept
+    {
+        auto index = index_of(key);
+        return index != npos ? &_slots[index].value : nullptr;
+    }
+
+    /// \brief Finds a value by key
+    /// \param key key of the value
+    /// \return pointer to the value, or null if the map has no such key
+    V const* find(string_key key) const noexcept
+    {
+        auto index = index_of(key);
+        return index != npos ? &_slots[index].value : nullptr;
+    }
+
+    /// \brief Gets a value by key, inserting a default value if the map has
+    /// no such key
+    /// \param key key of the value
+    /// \return reference to the value
+    V& operator[](string_key key)
+    {
+        auto value = find(key);
+        if (value != nullptr) {
+            return *value;
+        }
+
+        if ((_size + 1) * max_load_denominator
+            > _slots.size() * max_load_numerator)
+        {
+            rehash(_slots.empty() ? min_capacity : _slots.size() * 2);
+        }
+        auto& slot = _slots[free_index(key.hash())];
+        slot.key.assign(key.data(), key.size());
+        slot.hash = key.hash();
+        slot.is_used = true;
+        ++_size;
+        return slot.value;
+    }
+
+    /// \brief Erases a value by key
+    /// \param key key of the value
+    /// \return whether the value was erased
+    bool erase(string_key key)
+    {
+        auto index = index_of(key);
+        if (index == npos) {
+            return false;
+        }
+        erase_at(index);
+        return true;
+    }
+
+    /// \brief Erases the entries matching a predicate
+    /// \tparam Predicate type of predicate
+    /// \param pred predicate called once for each entry with its key and a
+    /// reference to its value, returning whether to erase it
+    /// \return number of entries erased
+    template <typename Predicate>
+    std::size_t erase_if(Predicate pred)
+    {
+        if (_size == 0) {
+            return 0;
+        }
+
+        // Entries are only ever shifted back within their run of used
+        // slots. Scanning from an empty slot, an entry shifted into the
+        // current slot therefore comes from one not yet visited.
+        auto mask = _slots.size() - 1;
+        std::size_t start{0};
+        while (_slots[start].is_used) {
+            ++start;
+        }
+        std::size_t count{0};
+        for (std::size_t i = 1; i < _slots.size(); ++i) {
+            auto index = (start + i) & mask;
+            while (_slots[index].is_used
+                && pred(static_cast<key_type const&>(_slots[index].key),
+                    _slots[index].value))
+            {
+                erase_at(index);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /// \brief Erases all entries
+    void clear() noexcept
+    {
+        _slots.clear();
+        _size = 0;
+    }
+
+private:
+    /// \brief Entry of the map, or an empty slot
+    struct slot_type
+    {
+        key_type key; //!< Key of the entry
+        V value{}; //!< Value of the entry
+        std::size_t hash{0}; //!< Hash of the key
+        bool is_used{false}; //!< Whether the slot holds an entry
+    };
+
+    /// \brief Index returned when no slot is found
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// \brief Smallest number of slots allocated
+    static constexpr std::size_t min_capacity = 8;
+
+    /// \brief Numerator of the fraction of slots used before growing
+    static constexpr std::size_t max_load_numerator = 3;
+
+    /// \brief Denominator of the fraction of slots used before growing
+    static constexpr std::size_t max_load_denominator = 4;
+
+    /// \brief Gets the slot a hash is placed at when it does not collide
+    /// \param hash hash of a key
+    /// \return index of the slot
+    ///
+    /// The hash is spread by Fibonacci hashing, which takes the high bits
+    /// of its product with the golden ratio, so that hashes differing only
+    /// in their high bits do not share slots.
+    std::size_t home_of(std::size_t hash) const noexcept
+    {
+        constexpr std::size_t golden = sizeof(std::size_t) > 4
+            ? static_cast<std::size_t>(0x9E3779B97F4A7C15ull)
+            : static_cast<std::size_t>(0x9E3779B9ul);
+        return (hash * golden) >> _shift;
+    }
+
+    /// \brief Finds the slot holding a key
+    /// \param key key to find
+    /// \return index of the slot, or \ref npos if the map has no such key
+    std::size_t index_of(string_key key) const noexcept
+    {
+        if (_size == 0) {
+            return npos;
+        }
+        auto mask = _slots.size() - 1;
+        for (auto index = home_of(key.hash()); _slots[index].is_used;
+            index = (index + 1) & mask)
+        {
+            auto& slot = _slots[index];
+            if (slot.hash == key.hash() && key.equals(slot.key)) {
+                return index;
+            }
+        }
+        return npos;
+    }
+
+    /// \brief Finds the first empty slot for a hash
+    /// \param hash hash of a key
+    /// \return index of the slot
+    std::size_t free_index(std::size_t hash) const noexcept
+    {
+        auto mask = _slots.size() - 1;
+        auto index = home_of(hash);
+        while (_slots[index].is_used) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    /// \brief Erases the entry in a slot, shifting back the entries that
+    /// were displaced past it
+    /// \param index index of the slot
+    void erase_at(std::size_t index)
+    {
+        auto mask = _slots.size() - 1;
+        for (auto next = (index + 1) & mask; _slots[next].is_used;
+            next = (next + 1) & mask)
+        {
+            // An entry may fill the hole if the hole is no further from
+            // the entry's home slot than the entry itself
+            auto home = home_of(_slots[next].hash);
+            if (((next - home) & mask) >= ((next - index) & mask)) {
+                _slots[index] = std::move(_slots[next]);
+                index = next;
+            }
+        }
+        _slots[index] = slot_type{};
+        --_size;
+    }
+
+    /// \brief Moves the entries into a new array of slots
+    /// \param capacity number of slots, which must be a power of two
+    void rehash(std::size_t capacity)
+    {
+        std::vector<slot_type> slots(capacity);
+        slots.swap(_slots);
+        _shift = std::numeric_limits<std::size_t>::digits;
+        for (auto size = capacity; size > 1; size /= 2) {
+            --_shift;
+        }
+        for (auto&& slot : slots) {
+            if (slot.is_used) {
+                _slots[free_index(slot.hash)] = std::move(slot);
+            }
+        }
+    }
+
+    std::vector<slot_type> _slots; //!< Slots, a power of two in number
+    std::size_t _size{0}; //!< Number of entries
+
+    /// \brief Number of bits the spread hash is shifted by to index the
+    /// slots
+    unsigned _shift{std::numeric_limits<std::size_t>::digits};
+};
+
+/// \}
+
+}
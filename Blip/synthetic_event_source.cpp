@@ -0,0 +1,44 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::synthetic_event_source class
+/// implementation
+/// \ingroup application
+
+#include "blip/synthetic_event_source.hpp"
+#include <utility>
+
+namespace blip {
+
+synthetic_event_source::synthetic_event_source(generator_type generator)
+    : _generator{std::move(generator)}
+{
+}
+
+void synthetic_event_source::next_frame()
+{
+    if (_has_started) {
+        ++_frame;
+    }
+    _has_started = true;
+
+    // Reuse the list's storage so that generating events does not allocate
+    // once the largest frame has been seen
+    _events.clear();
+    _next = 0;
+    if (_generator) {
+        _generator(_frame, _events);
+    }
+}
+
+bool synthetic_event_source::poll(sf::Event& event)
+{
+    if (_next == _events.size()) {
+        return false;
+    }
+    event = _events[_next++];
+    return true;
+}
+
+}
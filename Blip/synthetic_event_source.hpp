@@ -0,0 +1,66 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::synthetic_event_source class interface
+/// \ingroup application
+
+#pragma once
+
+#include "blip/event_source.hpp"
+#include <SFML/Window/Event.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Supplies events produced by a generator function
+///
+/// Used to drive the \ref application without a window, such as when
+/// benchmarking or soak testing in \ref application_mode::headless.
+class synthetic_event_source : public event_source
+{
+public:
+    /// \brief Type of function generating the events of a frame
+    ///
+    /// The function is given the index of the frame and appends its events
+    /// to the given list.
+    using generator_type =
+        std::function<void(std::size_t, std::vector<sf::Event>&)>;
+
+    /// \brief Initializes a new instance of the
+    /// \ref synthetic_event_source class that supplies no events
+    synthetic_event_source() = default;
+
+    /// \brief Initializes a new instance of the
+    /// \ref synthetic_event_source class with the given generator
+    /// \param generator event generation function
+    explicit synthetic_event_source(generator_type generator);
+
+    /// \brief Gets the index of the current frame
+    /// \return index of the current frame
+    std::size_t frame() const noexcept { return _frame; }
+
+    /// \brief Generates the events of the next frame
+    void next_frame() override;
+
+    /// \brief Pops the next generated event of the current frame
+    /// \param event event to pop into
+    /// \return whether an event was popped
+    bool poll(sf::Event& event) override;
+
+private:
+    generator_type _generator; //!< Event generation function
+    std::vector<sf::Event> _events; //!< Events of the current frame
+    std::size_t _next{0}; //!< Index of the next event to pop
+    std::size_t _frame{0}; //!< Index of the current frame
+    bool _has_started{false}; //!< Whether a frame has been generated
+};
+
+/// \}
+
+}
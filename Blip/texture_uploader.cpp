@@ -0,0 +1,121 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::texture_uploader class implementation
+/// \ingroup resource
+
+#include "blip/texture_uploader.hpp"
+#include "blip/trace.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+/// \brief Type of clock used to measure uploads
+using clock_type = std::chrono::steady_clock;
+
+/// \brief Weight of the newest measurement in the upload cost estimate
+constexpr double cost_smoothing = 0.25;
+
+}
+
+namespace blip {
+
+texture_uploader::texture_uploader(float budget)
+    : _budget{budget}
+{
+}
+
+texture_uploader::~texture_uploader() = default;
+
+std::size_t texture_uploader::pending_count() const
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _requests.size();
+}
+
+auto texture_uploader::upload(image_future image) -> texture_future
+{
+    request r;
+    r.image = std::move(image);
+    auto future = r.texture.get_future().share();
+    std::lock_guard<std::mutex> lock{_mutex};
+    _requests.emplace_back(std::move(r));
+    return future;
+}
+
+std::size_t texture_uploader::update()
+{
+    auto start = clock_type::now();
+    auto budget = std::chrono::duration<double, std::nano>{
+        static_cast<double>(_budget) * 1e6};
+    std::size_t count{0};
+    request r;
+    while (take_ready(r)) {
+        image_ptr image;
+        try {
+            image = r.image.get();
+        }
+        catch (...) {
+        }
+        if (image == nullptr) {
+            r.texture.set_value(nullptr);
+            continue;
+        }
+
+        auto size = image->getSize();
+        auto pixels = static_cast<double>(size.x) * size.y;
+        std::chrono::duration<double, std::nano> estimate{
+            pixels * _cost_per_pixel};
+        if (count > 0 && clock_type::now() - start + estimate > budget) {
+            // The request is put back to be uploaded first next frame
+            std::lock_guard<std::mutex> lock{_mutex};
+            _requests.emplace_front(std::move(r));
+            break;
+        }
+
+        auto upload_start = clock_type::now();
+        auto texture = std::make_shared<sf::Texture>();
+        {
+            trace_scope trace{"Upload texture"};
+            if (!texture->loadFromImage(*image)) {
+                texture = nullptr;
+            }
+        }
+        std::chrono::duration<double, std::nano> cost{
+            clock_type::now() - upload_start};
+        if (pixels > 0) {
+            auto sample = cost.count() / pixels;
+            _cost_per_pixel = _cost_per_pixel == 0.0
+                ? sample
+                : _cost_per_pixel + cost_smoothing
+                    * (sample - _cost_per_pixel);
+        }
+        r.texture.set_value(std::move(texture));
+        ++count;
+    }
+    return count;
+}
+
+bool texture_uploader::take_ready(request& to)
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    for (auto iter = std::begin(_requests); iter != std::end(_requests);
+        ++iter)
+    {
+        if (iter->image.wait_for(std::chrono::seconds{0})
+            == std::future_status::ready)
+        {
+            to = std::move(*iter);
+            _requests.erase(iter);
+            return true;
+        }
+    }
+    return false;
+}
+
+}
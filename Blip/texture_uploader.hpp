@@ -0,0 +1,121 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::texture_uploader class interface
+/// \ingroup resource
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+
+namespace sf {
+
+// Forward declarations
+class Image;
+class Texture;
+
+}
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Uploads decoded images to textures within a per-frame time budget
+///
+/// Loading a texture is split into two stages: the image is read and
+/// decoded on a worker thread, and then uploaded to the graphics device on
+/// the thread that calls \ref update, once per frame. Uploads stop for the
+/// frame before they would exceed the budget, estimated from the size of
+/// each image and the measured cost of previous uploads, although at least
+/// one upload is made each frame so that large textures are not starved.
+///
+/// Futures for uploaded textures become ready only through \ref update, so
+/// the thread calling it must never wait for them.
+class texture_uploader
+{
+public:
+    /// \brief Type of shared pointer for images
+    using image_ptr = std::shared_ptr<sf::Image>;
+
+    /// \brief Type of shared pointer for textures
+    using texture_ptr = std::shared_ptr<sf::Texture>;
+
+    /// \brief Type of future for decoded images
+    using image_future = std::shared_future<image_ptr>;
+
+    /// \brief Type of future for uploaded textures
+    using texture_future = std::shared_future<texture_ptr>;
+
+    /// \brief Default upload time budget per frame, in milliseconds
+    static constexpr float default_budget = 2.0f;
+
+    /// \brief Initializes a new instance of the \ref texture_uploader class
+    /// \param budget upload time budget per frame, in milliseconds
+    explicit texture_uploader(float budget = default_budget);
+
+    /// \brief Deleted copy constructor
+    texture_uploader(texture_uploader const&) = delete;
+
+    /// \brief Destructs the \ref texture_uploader instance
+    ~texture_uploader();
+
+    /// \brief Deleted copy assignment operator
+    texture_uploader& operator=(texture_uploader const&) = delete;
+
+    /// \brief Gets the upload time budget per frame
+    /// \return budget in milliseconds
+    float budget() const noexcept { return _budget; }
+
+    /// \brief Sets the upload time budget per frame
+    /// \param budget budget in milliseconds
+    void budget(float budget) noexcept { _budget = budget; }
+
+    /// \brief Gets the number of textures waiting to be uploaded
+    /// \return number of textures
+    std::size_t pending_count() const;
+
+    /// \brief Queues an image to be uploaded once it has been decoded
+    /// \param image future for the decoded image
+    /// \return future for the texture, which is null if the image could not
+    /// be decoded or uploaded
+    ///
+    /// May be called from any thread.
+    texture_future upload(image_future image);
+
+    /// \brief Uploads decoded images until the budget for the frame is spent
+    /// \return number of textures uploaded
+    ///
+    /// Must be called once per frame from a thread that can use the graphics
+    /// device.
+    std::size_t update();
+
+private:
+    /// \brief Image waiting to be uploaded
+    struct request
+    {
+        image_future image; //!< Future for the decoded image
+        std::promise<texture_ptr> texture; //!< Promise for the texture
+    };
+
+    /// \brief Takes the first request whose image has been decoded
+    /// \param to request to move the taken request into
+    /// \return whether a request was taken
+    bool take_ready(request& to);
+
+    mutable std::mutex _mutex; //!< Mutex guarding the requests
+    std::deque<request> _requests; //!< Requests in the order made
+    float _budget; //!< Upload time budget per frame, in milliseconds
+
+    /// \brief Estimated upload cost, in nanoseconds per pixel
+    double _cost_per_pixel{0.0};
+};
+
+/// \}
+
+}
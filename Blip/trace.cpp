@@ -0,0 +1,343 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the execution tracing implementation
+/// \ingroup profile
+
+#include "blip/trace.hpp"
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// \brief Type of clock used for trace timestamps
+using clock_type = std::chrono::steady_clock;
+
+/// \brief Number of records held by each thread buffer
+constexpr std::size_t buffer_capacity = 1 << 14;
+
+/// \brief Number of characters kept from a scope argument
+constexpr std::size_t arg_capacity = 40;
+
+/// \brief Interval at which thread buffers are drained to the file
+constexpr std::chrono::milliseconds flush_interval{50};
+
+/// \brief Single begin or end event
+struct trace_record
+{
+    char const* name; //!< Name of the scope
+    clock_type::rep time; //!< Time since the capture started
+    char phase; //!< Chrome trace event phase
+    char arg[arg_capacity]; //!< Scope argument, or empty
+};
+
+/// \brief Single-producer, single-consumer ring of records for a thread
+struct trace_buffer
+{
+    std::array<trace_record, buffer_capacity> records; //!< Record storage
+    std::atomic<std::size_t> head{0}; //!< Count of records written
+    std::atomic<std::size_t> tail{0}; //!< Count of records drained
+    std::atomic<char const*> name{nullptr}; //!< Name of the thread
+    unsigned id{0}; //!< Identifier of the thread in the trace
+    bool is_name_written{false}; //!< Whether the name has been written
+};
+
+/// \brief Shared state of the tracing system
+struct trace_state
+{
+    /// \brief Mutex guarding everything except the buffer contents
+    std::mutex mutex;
+
+    /// \brief Buffers of every thread that has recorded
+    std::vector<std::shared_ptr<trace_buffer>> buffers;
+
+    unsigned next_id{1}; //!< Identifier of the next thread buffer
+    std::ofstream file; //!< File being written
+    bool is_first_event{true}; //!< Whether no event has been written yet
+    std::thread flusher; //!< Thread draining buffers to the file
+    std::condition_variable wake; //!< Wakes the flusher early
+    bool should_stop{false}; //!< Whether the flusher should stop
+
+    /// \brief Clock time at which the capture started
+    std::atomic<clock_type::rep> epoch{0};
+};
+
+/// \brief Gets the shared state of the tracing system
+/// \return tracing state
+///
+/// The state is never destroyed so that threads may record during exit.
+trace_state& state()
+{
+    static auto s = new trace_state;
+    return *s;
+}
+
+/// \brief Gets the name of the calling thread
+/// \return reference to the static name, or null if unnamed
+char const*& local_name() noexcept
+{
+    thread_local char const* name{nullptr};
+    return name;
+}
+
+/// \brief Gets the buffer of the calling thread
+/// \return reference to the buffer, or null if none has been registered
+std::shared_ptr<trace_buffer>& local_buffer() noexcept
+{
+    thread_local std::shared_ptr<trace_buffer> buffer;
+    return buffer;
+}
+
+/// \brief Registers a buffer for the calling thread
+/// \return buffer, or null if it could not be allocated
+///
+/// Buffers are large, so one is only allocated once the thread records
+/// during a capture rather than when it is named.
+trace_buffer* register_buffer() noexcept
+{
+    auto& buffer = local_buffer();
+    try {
+        auto b = std::make_shared<trace_buffer>();
+        b->name.store(local_name(), std::memory_order_relaxed);
+
+        auto& s = state();
+        std::lock_guard<std::mutex> lock{s.mutex};
+        b->id = s.next_id;
+        s.buffers.emplace_back(b);
+        ++s.next_id;
+        buffer = std::move(b);
+    }
+    catch (std::exception const&) {
+        return nullptr;
+    }
+    return buffer.get();
+}
+
+/// \brief Appends a record to the calling thread's buffer
+/// \param name name of the scope
+/// \param phase Chrome trace event phase
+/// \param arg scope argument, or null
+void push(char const* name, char phase, char const* arg) noexcept
+{
+    auto p = local_buffer().get();
+    if (p == nullptr) {
+        // A scope that began before a capture ends without a buffer
+        if (phase == 'E' || (p = register_buffer()) == nullptr) {
+            return;
+        }
+    }
+
+    auto& b = *p;
+    auto head = b.head.load(std::memory_order_relaxed);
+    auto tail = b.tail.load(std::memory_order_acquire);
+    if (head - tail == buffer_capacity) {
+        return;
+    }
+
+    auto& r = b.records[head % buffer_capacity];
+    r.name = name;
+    r.time = clock_type::now().time_since_epoch().count()
+        - state().epoch.load(std::memory_order_relaxed);
+    r.phase = phase;
+    r.arg[0] = '\0';
+    if (arg != nullptr) {
+        std::strncpy(r.arg, arg, arg_capacity - 1);
+        r.arg[arg_capacity - 1] = '\0';
+    }
+    b.head.store(head + 1, std::memory_order_release);
+}
+
+/// \brief Writes a string as a JSON string literal
+/// \param os stream to write to
+/// \param str string to write
+void write_string(std::ostream& os, char const* str)
+{
+    os << '"';
+    for (; *str != '\0'; ++str) {
+        switch (*str) {
+            case '"':
+            case '\\':
+                os << '\\' << *str;
+                break;
+
+            default:
+                if (static_cast<unsigned char>(*str) >= 0x20) {
+                    os << *str;
+                }
+                break;
+        }
+    }
+    os << '"';
+}
+
+/// \brief Begins a new event in the trace file
+/// \param s tracing state
+void begin_event(trace_state& s)
+{
+    if (!s.is_first_event) {
+        s.file << ",\n";
+    }
+    s.is_first_event = false;
+}
+
+/// \brief Drains every thread buffer into the trace file
+/// \param s tracing state, whose mutex must be held
+void drain(trace_state& s)
+{
+    using microseconds = std::chrono::duration<double, std::micro>;
+
+    for (auto&& b : s.buffers) {
+        auto name = b->name.load(std::memory_order_relaxed);
+        if (name != nullptr && !b->is_name_written) {
+            begin_event(s);
+            s.file << R"({"name":"thread_name","ph":"M","pid":1,"tid":)"
+                << b->id << R"(,"args":{"name":)";
+            write_string(s.file, name);
+            s.file << "}}";
+            b->is_name_written = true;
+        }
+
+        auto tail = b->tail.load(std::memory_order_relaxed);
+        auto head = b->head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            auto& r = b->records[tail % buffer_capacity];
+            auto ts = microseconds{clock_type::duration{r.time}}.count();
+            begin_event(s);
+            s.file << R"({"name":)";
+            write_string(s.file, r.name);
+            s.file << R"(,"ph":")" << r.phase << R"(","ts":)" << ts
+                << R"(,"pid":1,"tid":)" << b->id;
+            if (r.arg[0] != '\0') {
+                s.file << R"(,"args":{"name":)";
+                write_string(s.file, r.arg);
+                s.file << '}';
+            }
+            s.file << '}';
+        }
+        b->tail.store(tail, std::memory_order_release);
+    }
+}
+
+/// \brief Finishes the trace file
+/// \param s tracing state, whose mutex must be held
+void finish(trace_state& s)
+{
+    if (!s.file.is_open()) {
+        return;
+    }
+    drain(s);
+    s.file << "\n]}\n";
+    s.file.close();
+}
+
+/// \brief Drains thread buffers until stopped or the capture expires
+/// \param duration length of the capture, or zero if unlimited
+void flush(std::chrono::milliseconds duration)
+{
+    auto& s = state();
+    auto deadline = clock_type::now() + duration;
+    std::unique_lock<std::mutex> lock{s.mutex};
+    while (!s.should_stop) {
+        s.wake.wait_for(lock, flush_interval);
+        if (duration != duration.zero() && clock_type::now() >= deadline) {
+            blip::detail::is_tracing = false;
+            finish(s);
+            return;
+        }
+        drain(s);
+    }
+}
+
+}
+
+namespace blip {
+
+namespace detail {
+
+std::atomic<bool> is_tracing{false};
+
+void trace_begin(char const* name, char const* arg) noexcept
+{
+    push(name, 'B', arg);
+}
+
+void trace_end(char const* name) noexcept
+{
+    push(name, 'E', nullptr);
+}
+
+}
+
+bool start_trace(
+    std::string const& path,
+    std::chrono::milliseconds duration)
+{
+#if BLIP_ENABLE_TRACE
+    stop_trace();
+
+    auto& s = state();
+    std::lock_guard<std::mutex> lock{s.mutex};
+    s.file.open(path);
+    if (!s.file) {
+        return false;
+    }
+    s.file << R"({"displayTimeUnit":"ms","traceEvents":[)" << '\n';
+    s.is_first_event = true;
+
+    // Discard anything recorded after a previous capture stopped
+    for (auto&& b : s.buffers) {
+        b->tail.store(b->head.load(std::memory_order_acquire),
+            std::memory_order_release);
+        b->is_name_written = false;
+    }
+
+    s.epoch = clock_type::now().time_since_epoch().count();
+    s.should_stop = false;
+    s.flusher = std::thread{flush, duration};
+    detail::is_tracing = true;
+    return true;
+#else
+    static_cast<void>(path);
+    static_cast<void>(duration);
+    return false;
+#endif
+}
+
+void stop_trace()
+{
+    auto& s = state();
+    detail::is_tracing = false;
+
+    std::unique_lock<std::mutex> lock{s.mutex};
+    s.should_stop = true;
+    s.wake.notify_all();
+    if (s.flusher.joinable()) {
+        lock.unlock();
+        s.flusher.join();
+        lock.lock();
+    }
+    finish(s);
+}
+
+void trace_thread_name(char const* name) noexcept
+{
+#if BLIP_ENABLE_TRACE
+    local_name() = name;
+    auto& buffer = local_buffer();
+    if (buffer != nullptr) {
+        buffer->name.store(name, std::memory_order_relaxed);
+    }
+#else
+    static_cast<void>(name);
+#endif
+}
+
+}
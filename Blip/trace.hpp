@@ -0,0 +1,113 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the execution tracing interface
+/// \ingroup profile
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/// \brief Whether execution tracing is compiled in
+///
+/// Define as 0 to compile out all trace instrumentation; the tracing
+/// functions remain available but record nothing.
+#ifndef BLIP_ENABLE_TRACE
+#define BLIP_ENABLE_TRACE 1
+#endif
+
+namespace blip {
+
+/// \addtogroup profile
+/// \{
+
+namespace detail {
+
+/// \brief Whether a trace is being captured
+extern std::atomic<bool> is_tracing;
+
+/// \brief Records the beginning of a traced scope on the calling thread
+/// \param name static name of the scope
+/// \param arg optional argument of the scope, copied and truncated
+void trace_begin(char const* name, char const* arg) noexcept;
+
+/// \brief Records the end of a traced scope on the calling thread
+/// \param name static name of the scope
+void trace_end(char const* name) noexcept;
+
+}
+
+/// \brief Starts capturing a trace to a file
+/// \param path path to the trace file
+/// \param duration length of the capture, or zero to capture until
+/// \ref stop_trace is called
+/// \return whether the capture was started
+///
+/// The file is written in the Chrome trace event format, which can be
+/// loaded by chrome://tracing and Perfetto. Each thread records into its own
+/// lock-free buffer; a background thread drains the buffers into the file
+/// so that recording never blocks on I/O. Events are dropped rather than
+/// blocking if a buffer fills faster than it is drained.
+bool start_trace(
+    std::string const& path,
+    std::chrono::milliseconds duration = std::chrono::milliseconds::zero());
+
+/// \brief Stops capturing a trace and finishes writing its file
+void stop_trace();
+
+/// \brief Gets a value indicating whether a trace is being captured
+/// \return whether a trace is being captured
+inline bool is_tracing() noexcept
+{
+    return BLIP_ENABLE_TRACE
+        && detail::is_tracing.load(std::memory_order_relaxed);
+}
+
+/// \brief Names the calling thread in captured traces
+/// \param name static name of the thread
+void trace_thread_name(char const* name) noexcept;
+
+/// \brief Records a scope in the captured trace, if any
+///
+/// When no trace is being captured, this costs a single atomic load. When
+/// \ref BLIP_ENABLE_TRACE is 0, it does nothing.
+class trace_scope
+{
+public:
+    /// \brief Initializes a new instance of the \ref trace_scope class with
+    /// the given name
+    /// \param name static name of the scope
+    /// \param arg optional argument of the scope, such as a resource name
+    explicit trace_scope(char const* name, char const* arg = nullptr)
+        noexcept
+        : _name{is_tracing() ? name : nullptr}
+    {
+        if (_name != nullptr) {
+            detail::trace_begin(_name, arg);
+        }
+    }
+
+    /// \brief Deleted copy constructor
+    trace_scope(trace_scope const&) = delete;
+
+    /// \brief Records the end of the scope
+    ~trace_scope()
+    {
+        if (_name != nullptr) {
+            detail::trace_end(_name);
+        }
+    }
+
+    /// \brief Deleted copy assignment operator
+    trace_scope& operator=(trace_scope const&) = delete;
+
+private:
+    char const* _name; //!< Name of the scope, or null if not recorded
+};
+
+/// \}
+
+}
@@ -0,0 +1,23 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::window_event_source class implementation
+/// \ingroup application
+
+#include "blip/window_event_source.hpp"
+#include <SFML/Window/Window.hpp>
+
+namespace blip {
+
+window_event_source::window_event_source(sf::Window& window)
+    : _window{window}
+{
+}
+
+bool window_event_source::poll(sf::Event& event)
+{
+    return _window.pollEvent(event);
+}
+
+}
@@ -0,0 +1,44 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::window_event_source class interface
+/// \ingroup application
+
+#pragma once
+
+#include "blip/event_source.hpp"
+
+namespace sf {
+
+// Forward declarations
+class Window;
+
+}
+
+namespace blip {
+
+/// \addtogroup application
+/// \{
+
+/// \brief Supplies the events of a window
+class window_event_source : public event_source
+{
+public:
+    /// \brief Initializes a new instance of the \ref window_event_source
+    /// class with the given window
+    /// \param window window to poll events from
+    explicit window_event_source(sf::Window& window);
+
+    /// \brief Pops the next pending event of the window
+    /// \param event event to pop into
+    /// \return whether an event was popped
+    bool poll(sf::Event& event) override;
+
+private:
+    sf::Window& _window; //!< Window to poll events from
+};
+
+/// \}
+
+}
@@ -0,0 +1,69 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::worker_pool class implementation
+/// \ingroup resource
+
+#include "blip/worker_pool.hpp"
+#include "blip/trace.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace blip {
+
+worker_pool::worker_pool(std::size_t thread_count)
+    : _thread_count{thread_count}
+{
+    if (_thread_count == 0) {
+        auto hardware = std::thread::hardware_concurrency();
+        _thread_count = std::max(hardware, 2u) - 1;
+    }
+}
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _should_stop = true;
+        _tasks.clear();
+    }
+    _wake.notify_all();
+    for (auto&& thread : _threads) {
+        thread.join();
+    }
+}
+
+void worker_pool::submit(task_type task)
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _tasks.emplace_back(std::move(task));
+        if (_threads.empty()) {
+            _threads.reserve(_thread_count);
+            for (std::size_t i = 0; i < _thread_count; ++i) {
+                _threads.emplace_back(&worker_pool::work, this);
+            }
+        }
+    }
+    _wake.notify_one();
+}
+
+void worker_pool::work()
+{
+    trace_thread_name("Worker");
+    std::unique_lock<std::mutex> lock{_mutex};
+    while (true) {
+        _wake.wait(lock, [this] { return _should_stop || !_tasks.empty(); });
+        if (_should_stop) {
+            return;
+        }
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref blip::worker_pool class interface
+/// \ingroup resource
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace blip {
+
+/// \addtogroup resource
+/// \{
+
+/// \brief Fixed pool of threads running tasks in submission order
+///
+/// The threads are started on the first submission, so a pool that is
+/// never used costs nothing. Tasks still queued when the pool is destroyed
+/// are discarded; the tasks being run are waited for.
+class worker_pool
+{
+public:
+    /// \brief Type of task run by the pool
+    using task_type = std::function<void()>;
+
+    /// \brief Initializes a new instance of the \ref worker_pool class
+    /// \param thread_count number of threads, or zero for one fewer than the
+    /// number of hardware threads, with a minimum of one
+    explicit worker_pool(std::size_t thread_count = 0);
+
+    /// \brief Deleted copy constructor
+    worker_pool(worker_pool const&) = delete;
+
+    /// \brief Destructs the \ref worker_pool instance, stopping its threads
+    ~worker_pool();
+
+    /// \brief Deleted copy assignment operator
+    worker_pool& operator=(worker_pool const&) = delete;
+
+    /// \brief Gets the number of threads in the pool
+    /// \return number of threads
+    std::size_t thread_count() const noexcept { return _thread_count; }
+
+    /// \brief Queues a task to be run by the pool
+    /// \param task task to run, which must not throw
+    void submit(task_type task);
+
+private:
+    /// \brief Runs queued tasks until the pool is stopped
+    void work();
+
+    std::size_t _thread_count; //!< Number of threads
+    std::vector<std::thread> _threads; //!< Started threads
+    std::deque<task_type> _tasks; //!< Queued tasks
+    std::mutex _mutex; //!< Mutex guarding the queue and the stop flag
+    std::condition_variable _wake; //!< Wakes a thread for a queued task
+    bool _should_stop{false}; //!< Whether the threads should stop
+};
+
+/// \}
+
+}
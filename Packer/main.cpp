@@ -0,0 +1,60 @@
+// Blip
+// Copyright (c) Xettex 2016
+
+/// \file
+/// \brief Contains the \ref main function of the resource packer
+/// \ingroup packer
+
+#include "blip/path.hpp"
+#include "blip/resource_archive.hpp"
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+/// \addtogroup packer
+/// \{
+
+/// \brief The entry point of the resource packer
+/// \param argc number of command line arguments
+/// \param argv command line arguments
+/// \return exit status of the program
+///
+/// Usage: \c Packer \c RESOURCES \c ARCHIVE
+///
+/// Packs every file under the resources directory \c RESOURCES into the
+/// \ref blip::resource_archive \c ARCHIVE, which is replaced. The archive is
+/// installed alongside the resources directory as
+/// \ref blip::application::resource_archive_name, and the application then
+/// loads resources from it instead of the loose files.
+int main(int argc, char* argv[])
+{
+    using namespace blip;
+
+    if (argc != 3) {
+        std::cerr << "usage: Packer RESOURCES ARCHIVE\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string root{argv[1]};
+    std::string archive_path{argv[2]};
+    auto paths = list_files(root);
+    if (paths.empty()) {
+        std::cerr << "no resources found in " << root << '\n';
+        return EXIT_FAILURE;
+    }
+
+    try {
+        resource_archive::pack(archive_path, root, paths);
+    }
+    catch (std::exception const& e) {
+        std::cerr << "unable to pack resources: " << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "packed " << paths.size() << " resources into "
+        << archive_path << '\n';
+    return EXIT_SUCCESS;
+}
+
+/// \}